@@ -2,10 +2,19 @@
 #define ASR_UTILS_H
 
 #include "asr_utils/asr_extensions.h"
+#include "asr_utils/executable_file.h"
 #include "asr_utils/mem_watcher.h"
+#include "asr_utils/page_cache.h"
 #include "asr_utils/process_info.h"
 #include "asr_utils/read_mem.h"
+#include "asr_utils/remote_collections.h"
+#include "asr_utils/remote_string.h"
+#include "asr_utils/remote_string_table.h"
+#include "asr_utils/remote_struct.h"
 #include "asr_utils/sigscan.h"
+#include "asr_utils/sigscan_cache.h"
+#include "asr_utils/typed_process.h"
 #include "asr_utils/variable.h"
+#include "asr_utils/x86_decoder.h"
 
 #endif /* ASR_UTILS_H */
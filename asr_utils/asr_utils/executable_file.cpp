@@ -0,0 +1,384 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/executable_file.h"
+#include "asr_utils/asr_extensions.h"
+#include "asr_utils/internal/unique_file.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+namespace {
+
+/*
+Scanning the file on disk means we can grab everything in a handful of large sequential reads,
+rather than making thousands of `process_read` calls, and we don't need to wait for the game to
+finish setting up it's memory.
+
+The catch is we need to work out where each part of the file ends up. For PEs, we've already read
+the section table out of memory. For ELFs we parse the program headers here, since nothing else
+needs them.
+
+Under proton, the executable path might point at wine rather than the game (see `ProcessInfo`), so
+before trusting the file we make sure it's headers match what's mapped at the main module. We can't
+just compare the raw bytes, since the loader rewrites some fields - most notably the PE image base
+when it's relocated. Instead we compare fields which identify the build: for PEs the signature,
+timestamp, checksum and image size; for ELFs the identification bytes and the program headers. The
+program headers are assumed to be mapped at the same offset they're at in the file, which holds for
+the default layout of every common linker.
+*/
+
+const constexpr auto PE_LFA_NEW_OFFSET = 0x3C;
+const constexpr auto PE_NT_HEADER_SIG_TIMESTAMP_PADDING = 0x4;
+const constexpr auto PE_NT_HEADER_TIMESTAMP_SIZEOFIMAGE_PADDING = 0x44;
+const constexpr Address ELF_PAGE_MASK = 0xFFF;
+const constexpr uint32_t ELF_PT_LOAD = 1;
+const constexpr auto ELF_EI_NIDENT = 16;
+
+struct PEIdentityHeader {
+    uint8_t sig[4];
+    uint8_t padding1[PE_NT_HEADER_SIG_TIMESTAMP_PADDING];
+    uint32_t time_date_stamp;
+    uint8_t padding2[PE_NT_HEADER_TIMESTAMP_SIZEOFIMAGE_PADDING];
+    uint32_t size_of_image;
+    uint32_t size_of_headers;
+    uint32_t checksum;
+};
+
+struct ELF32Header {
+    uint8_t e_ident[ELF_EI_NIDENT];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint32_t e_entry;
+    uint32_t e_phoff;
+    uint32_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+};
+
+struct ELF32ProgramHeader {
+    uint32_t p_type;
+    uint32_t p_offset;
+    uint32_t p_vaddr;
+    uint32_t p_paddr;
+    uint32_t p_filesz;
+    uint32_t p_memsz;
+    uint32_t p_flags;
+    uint32_t p_align;
+};
+
+struct ELF64Header {
+    uint8_t e_ident[ELF_EI_NIDENT];
+    uint16_t e_type;
+    uint16_t e_machine;
+    uint32_t e_version;
+    uint64_t e_entry;
+    uint64_t e_phoff;
+    uint64_t e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize;
+    uint16_t e_phentsize;
+    uint16_t e_phnum;
+};
+
+struct ELF64ProgramHeader {
+    uint32_t p_type;
+    uint32_t p_flags;
+    uint64_t p_offset;
+    uint64_t p_vaddr;
+    uint64_t p_paddr;
+    uint64_t p_filesz;
+    uint64_t p_memsz;
+    uint64_t p_align;
+};
+
+/**
+ * @brief A range of the file, and where it gets mapped to.
+ */
+struct MappedRange {
+    size_t file_offset;
+    Address rva;
+    size_t size;
+};
+
+/**
+ * @brief Reads a block of a file.
+ *
+ * @param file The file to read from.
+ * @param offset The offset to start reading at.
+ * @param buffer The buffer to read into. Determines the size of the read.
+ * @return True on success.
+ */
+bool read_at(FILE* file, size_t offset, std::span<uint8_t> buffer) {
+    // `long` is only 32 bits on wasm32, don't let large offsets wrap around
+    if (offset > static_cast<size_t>(std::numeric_limits<long>::max())) {
+        return false;
+    }
+    if (fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+        return false;
+    }
+    return fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+}
+
+/**
+ * @brief Checks that the identifying PE header fields in the file match the main module's.
+ *
+ * @param process The process the file belongs to.
+ * @param file The file to check.
+ * @return True if the headers match.
+ */
+bool pe_headers_match(const ProcessInfo& process, FILE* file) {
+    uint32_t lfa_new{};
+    if (!read_at(file, PE_LFA_NEW_OFFSET,
+                 {reinterpret_cast<uint8_t*>(&lfa_new), sizeof(lfa_new)})) {
+        return false;
+    }
+    lfa_new = fix_endianness(process, lfa_new);
+
+    PEIdentityHeader on_disk{};
+    PEIdentityHeader in_memory{};
+    if (!read_at(file, lfa_new, {reinterpret_cast<uint8_t*>(&on_disk), sizeof(on_disk)})) {
+        return false;
+    }
+    if (!process_read(process.pid, process.main_module + lfa_new, in_memory)) {
+        return false;
+    }
+
+    return memcmp(&on_disk.sig[0], &in_memory.sig[0], sizeof(on_disk.sig)) == 0
+           && on_disk.time_date_stamp == in_memory.time_date_stamp
+           && on_disk.size_of_image == in_memory.size_of_image
+           && on_disk.checksum == in_memory.checksum;
+}
+
+/**
+ * @brief Checks that the ELF identification and program headers in the file match the main
+ *        module's.
+ *
+ * @tparam Header The ELF header type to use.
+ * @param process The process the file belongs to.
+ * @param file The file to check.
+ * @return True if the headers match.
+ */
+template <typename Header>
+bool elf_headers_match(const ProcessInfo& process, FILE* file) {
+    Header on_disk{};
+    Header in_memory{};
+    if (!read_at(file, 0, {reinterpret_cast<uint8_t*>(&on_disk), sizeof(on_disk)})) {
+        return false;
+    }
+    if (!process_read(process.pid, process.main_module, in_memory)) {
+        return false;
+    }
+    if (memcmp(&on_disk.e_ident[0], &in_memory.e_ident[0], sizeof(on_disk.e_ident)) != 0) {
+        return false;
+    }
+
+    auto phoff = fix_endianness(process, on_disk.e_phoff);
+    auto table_size = static_cast<size_t>(fix_endianness(process, on_disk.e_phentsize))
+                      * fix_endianness(process, on_disk.e_phnum);
+    if (table_size == 0 || table_size > process.main_module_size) {
+        return false;
+    }
+
+    std::vector<uint8_t> disk_table(table_size);
+    std::vector<uint8_t> memory_table(table_size);
+    if (!read_at(file, phoff, disk_table)) {
+        return false;
+    }
+    if (!process_read(process.pid, process.main_module + phoff, memory_table.data(), table_size)) {
+        return false;
+    }
+    return disk_table == memory_table;
+}
+
+/**
+ * @brief Checks that the file's headers match what's mapped at the main module.
+ *
+ * @param process The process the file belongs to.
+ * @param file The file to check.
+ * @return True if the headers match.
+ */
+bool headers_match(const ProcessInfo& process, FILE* file) {
+    switch (process.exe_format) {
+        case ProcessInfo::ExecutableFormat::PE:
+            return pe_headers_match(process, file);
+        case ProcessInfo::ExecutableFormat::ELF:
+            return process.is_64_bit ? elf_headers_match<ELF64Header>(process, file)
+                                     : elf_headers_match<ELF32Header>(process, file);
+        case ProcessInfo::ExecutableFormat::UNKNOWN:
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Gets the mapped ranges described by an ELF's program headers.
+ *
+ * @tparam Header The ELF header type to use.
+ * @tparam ProgramHeader The program header type to use.
+ * @param process The process the file belongs to.
+ * @param file The file to read from.
+ * @param ranges The vector to append the mapped ranges to.
+ * @return True if we successfully read the program headers.
+ */
+template <typename Header, typename ProgramHeader>
+bool get_elf_ranges(const ProcessInfo& process, FILE* file, std::vector<MappedRange>& ranges) {
+    Header header{};
+    if (!read_at(file, 0, {reinterpret_cast<uint8_t*>(&header), sizeof(header)})) {
+        return false;
+    }
+
+    auto phoff = fix_endianness(process, header.e_phoff);
+    auto phentsize = fix_endianness(process, header.e_phentsize);
+    auto phnum = fix_endianness(process, header.e_phnum);
+    if (phentsize < sizeof(ProgramHeader)) {
+        runtime_print_message("ELF has unexpected program header size {:x}", phentsize);
+        return false;
+    }
+
+    std::vector<uint8_t> table(static_cast<size_t>(phentsize) * phnum);
+    if (!read_at(file, phoff, table)) {
+        return false;
+    }
+
+    // The main module starts at the page holding the lowest loaded address
+    std::vector<ProgramHeader> loads{};
+    auto base = std::numeric_limits<Address>::max();
+    for (size_t i = 0; i < phnum; i++) {
+        ProgramHeader program_header{};
+        memcpy(&program_header, &table[i * phentsize], sizeof(program_header));
+        if (fix_endianness(process, program_header.p_type) != ELF_PT_LOAD) {
+            continue;
+        }
+        base = std::min<Address>(base, fix_endianness(process, program_header.p_vaddr));
+        loads.push_back(program_header);
+    }
+    base &= ~ELF_PAGE_MASK;
+
+    for (const auto& load : loads) {
+        auto size = fix_endianness(process, load.p_filesz);
+        if (size == 0) {
+            continue;
+        }
+        ranges.push_back({static_cast<size_t>(fix_endianness(process, load.p_offset)),
+                          fix_endianness(process, load.p_vaddr) - base,
+                          static_cast<size_t>(size)});
+    }
+    return true;
+}
+
+/**
+ * @brief Reads all mapped ranges out of a file.
+ *
+ * @param file The file to read from.
+ * @param ranges The ranges to read.
+ * @param segments The vector to fill with the read segments.
+ * @return True if all ranges were read successfully.
+ */
+template <typename Segment>
+bool read_ranges(FILE* file, std::vector<MappedRange>& ranges, std::vector<Segment>& segments) {
+    // Read in file order, so all our reads are sequential
+    std::sort(ranges.begin(), ranges.end(), [](const MappedRange& lhs, const MappedRange& rhs) {
+        return lhs.file_offset < rhs.file_offset;
+    });
+
+    segments.clear();
+    segments.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        Segment segment{range.rva, std::vector<uint8_t>(range.size)};
+        if (!read_at(file, range.file_offset, segment.data)) {
+            segments.clear();
+            return false;
+        }
+        segments.push_back(std::move(segment));
+    }
+
+    // But scan in memory order, so we return the same match a memory scan would
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment& lhs, const Segment& rhs) { return lhs.rva < rhs.rva; });
+    return true;
+}
+
+}  // namespace
+
+bool ExecutableFile::try_load_pe(const ProcessInfo& process, FILE* file) {
+    if (process.sections.empty()) {
+        return false;
+    }
+
+    std::vector<MappedRange> ranges{};
+    for (const auto& section : process.sections) {
+        // Raw data is padded to the file alignment, don't include more than actually gets mapped
+        auto size = section.raw_size;
+        if (section.size != 0) {
+            size = std::min(size, section.size);
+        }
+        if (size == 0) {
+            continue;
+        }
+        ranges.push_back({section.raw_offset, section.rva, size});
+    }
+
+    return read_ranges(file, ranges, this->segments);
+}
+
+bool ExecutableFile::try_load_elf(const ProcessInfo& process, FILE* file) {
+    std::vector<MappedRange> ranges{};
+    auto success = process.is_64_bit
+                       ? get_elf_ranges<ELF64Header, ELF64ProgramHeader>(process, file, ranges)
+                       : get_elf_ranges<ELF32Header, ELF32ProgramHeader>(process, file, ranges);
+    if (!success) {
+        return false;
+    }
+
+    return read_ranges(file, ranges, this->segments);
+}
+
+ExecutableFile::ExecutableFile(const ProcessInfo& process) : main_module(process.main_module) {
+    internal::UniqueFile file{fopen(process.exe_path.c_str(), "rb")};
+    if (!file) {
+        runtime_print_message("Failed to open executable '{}'", process.exe_path);
+        return;
+    }
+
+    if (!headers_match(process, file.get())) {
+        runtime_print_message("Executable '{}' does not match the main module", process.exe_path);
+        return;
+    }
+
+    bool success = false;
+    switch (process.exe_format) {
+        case ProcessInfo::ExecutableFormat::PE:
+            success = this->try_load_pe(process, file.get());
+            break;
+        case ProcessInfo::ExecutableFormat::ELF:
+            success = this->try_load_elf(process, file.get());
+            break;
+        case ProcessInfo::ExecutableFormat::UNKNOWN:
+        default:
+            break;
+    }
+
+    if (!success) {
+        runtime_print_message("Failed to read executable '{}'", process.exe_path);
+    }
+}
+
+bool ExecutableFile::is_loaded(void) const {
+    return !this->segments.empty();
+}
+
+Address ExecutableFile::sigscan(const PatternView& pattern) const {
+    for (const auto& segment : this->segments) {
+        auto offset = sigscan_buffer(pattern, segment.data);
+        if (offset.has_value()) {
+            return this->main_module + segment.rva + *offset + pattern.offset;
+        }
+    }
+    return 0;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
@@ -0,0 +1,80 @@
+#ifndef ASR_UTILS_EXECUTABLE_FILE_H
+#define ASR_UTILS_EXECUTABLE_FILE_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/sigscan.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief A local copy of the main module's executable, read from disk through WASI.
+ * @note Only the parts of the file which get mapped into memory are kept, each stored alongside the
+ *       offset it gets mapped to.
+ * @note Packed or self modifying executables will not match what ends up in memory - in those cases
+ *       you'll still need to scan the process itself.
+ */
+class ExecutableFile {
+   private:
+    struct Segment {
+        Address rva;
+        std::vector<uint8_t> data;
+    };
+
+    Address main_module{0};
+    std::vector<Segment> segments;
+
+    /**
+     * @brief Loads the segments of a PE, using the section table we already read from memory.
+     *
+     * @param process The process the file belongs to.
+     * @param file The file to read from.
+     * @return True if we successfully loaded the file.
+     */
+    bool try_load_pe(const ProcessInfo& process, FILE* file);
+
+    /**
+     * @brief Parses an ELF's program headers, and loads it's segments.
+     *
+     * @param process The process the file belongs to.
+     * @param file The file to read from.
+     * @return True if we successfully loaded the file.
+     */
+    bool try_load_elf(const ProcessInfo& process, FILE* file);
+
+   public:
+    /**
+     * @brief Reads the main module's executable from disk.
+     * @note Checks the file's headers match those in memory, to make sure we've got the right file.
+     *
+     * @param process The process to read the executable of.
+     */
+    explicit ExecutableFile(const ProcessInfo& process);
+    ExecutableFile(ProcessId process) = delete;
+
+    /**
+     * @brief Checks if the executable was successfully loaded.
+     *
+     * @return True if loaded.
+     */
+    [[nodiscard]] bool is_loaded(void) const;
+
+    /**
+     * @brief Performs a sigscan over the executable.
+     * @note Only matches within a single segment are found.
+     *
+     * @param pattern The pattern to search for.
+     * @return The address the match corresponds to in the process, or 0 if not found.
+     */
+    [[nodiscard]] Address sigscan(const PatternView& pattern) const;
+    template <size_t n>
+    [[nodiscard]] Address sigscan(const Pattern<n>& pattern) const {
+        return this->sigscan(pattern.view());
+    }
+};
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_EXECUTABLE_FILE_H */
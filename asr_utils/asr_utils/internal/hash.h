@@ -0,0 +1,31 @@
+#ifndef ASR_UTILS_INTERNAL_HASH_H
+#define ASR_UTILS_INTERNAL_HASH_H
+
+#include "asr_utils/pch.h"
+
+// Internal helper, not part of the public API.
+
+namespace asr_utils {
+inline namespace v0 {
+namespace internal {
+
+// 2^64 divided by the golden ratio, which spreads sequential keys evenly over the table
+// NOLINTNEXTLINE(readability-magic-numbers)
+const constexpr uint64_t HASH_MULTIPLIER = 0x9E3779B97F4A7C15;
+
+/**
+ * @brief Gets the slot a key should start probing at, in a power of two sized hash table.
+ *
+ * @param key The key to hash.
+ * @param mask The slot index mask, one less than the table size.
+ * @return The slot index.
+ */
+inline size_t hash_slot(uint64_t key, size_t mask) {
+    return static_cast<size_t>((key * HASH_MULTIPLIER) >> 32) & mask;
+}
+
+}  // namespace internal
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_INTERNAL_HASH_H */
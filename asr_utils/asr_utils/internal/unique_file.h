@@ -0,0 +1,28 @@
+#ifndef ASR_UTILS_INTERNAL_UNIQUE_FILE_H
+#define ASR_UTILS_INTERNAL_UNIQUE_FILE_H
+
+#include "asr_utils/pch.h"
+
+// Internal helper, not part of the public API.
+
+namespace asr_utils {
+inline namespace v0 {
+namespace internal {
+
+/**
+ * @brief Deleter for unique pointers holding a file.
+ */
+struct FileCloser {
+    void operator()(FILE* file) const {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        fclose(file);
+    }
+};
+
+using UniqueFile = std::unique_ptr<FILE, FileCloser>;
+
+}  // namespace internal
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_INTERNAL_UNIQUE_FILE_H */
@@ -9,10 +9,16 @@
 namespace asr_utils {
 inline namespace v0 {
 
-template <typename T>
+/**
+ * @brief Watches a value in memory for changes.
+ *
+ * @tparam T The type of value to watch.
+ * @tparam Pointer The pointer path type, e.g. `DeepPointer` or `StaticDeepPointer`.
+ */
+template <typename T, typename Pointer = DeepPointer>
 class MemWatcher {
    private:
-    DeepPointer ptr{};
+    Pointer ptr{};
     T current_value{};
     T old_value{};
     std::unique_ptr<Variable<T>> var{nullptr};
@@ -25,8 +31,8 @@ class MemWatcher {
      * @param var A variable to store the watcher's current value in. May be null.
      */
     MemWatcher(void) = default;
-    MemWatcher(DeepPointer&& ptr, std::unique_ptr<Variable<T>>&& var = nullptr)
-        : ptr(ptr), var(std::move(var)) {}
+    MemWatcher(Pointer ptr, std::unique_ptr<Variable<T>>&& var = nullptr)
+        : ptr(std::move(ptr)), var(std::move(var)) {}
 
     /**
      * @brief Updates the stored values.
@@ -76,9 +82,9 @@ class MemWatcher {
      * @note Only valid for the lifetime of the watcher.
      * @note Intended to be used to edit the pointer, rather than needing to create a new watcher.
      *
-     * @return The deep pointer.
+     * @return The pointer path.
      */
-    [[nodiscard]] DeepPointer& pointer(void) { return this->ptr; }
+    [[nodiscard]] Pointer& pointer(void) { return this->ptr; }
 };
 
 }  // namespace v0
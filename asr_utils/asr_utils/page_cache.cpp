@@ -0,0 +1,95 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/page_cache.h"
+#include "asr_utils/internal/hash.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/*
+The cache is an open addressed hash table, with linear probing over a handful of slots. Rather than
+clearing it every tick, each slot stores the generation it was filled in, and anything from an older
+generation counts as empty.
+
+Unreadable pages are cached too, so that repeated reads of a bad pointer only cost one host call,
+rather than a failed page read on top of the direct read we fall back to.
+*/
+
+PageCache::PageCache(size_t capacity)
+    : slots(std::bit_ceil(std::max<size_t>(capacity, 1)), Slot{0, 0, false}),
+      data(slots.size() * PAGE_SIZE) {}
+
+const uint8_t* PageCache::get_page(ProcessId process, Address page) {
+    auto mask = this->slots.size() - 1;
+    auto home = internal::hash_slot(page / PAGE_SIZE, mask);
+
+    std::optional<size_t> empty_idx{};
+    for (size_t probe = 0; probe < std::min(MAX_PROBES, this->slots.size()); probe++) {
+        auto idx = (home + probe) & mask;
+        auto& slot = this->slots[idx];
+
+        if (slot.generation != this->generation) {
+            if (!empty_idx.has_value()) {
+                empty_idx = idx;
+            }
+            continue;
+        }
+        if (slot.page == page) {
+            this->hit_count++;
+            return slot.readable ? &this->data[idx * PAGE_SIZE] : nullptr;
+        }
+    }
+
+    // If every slot we looked at is taken, just evict the first
+    auto idx = empty_idx.value_or(home);
+    auto* page_data = &this->data[idx * PAGE_SIZE];
+
+    this->miss_count++;
+    auto readable = ::process_read(process, page, page_data, PAGE_SIZE);
+    this->slots[idx] = {page, this->generation, readable};
+    return readable ? page_data : nullptr;
+}
+
+bool PageCache::read(ProcessId process, Address address, uint8_t* buf, size_t size) {
+    if (size >= PAGE_SIZE) {
+        return ::process_read(process, address, buf, size);
+    }
+
+    auto end = address + size;
+    size_t offset = 0;
+    for (auto current = address; current < end;) {
+        auto page = current & ~static_cast<Address>(PAGE_SIZE - 1);
+        auto chunk_size = std::min<Address>(end, page + PAGE_SIZE) - current;
+
+        const auto* page_data = this->get_page(process, page);
+        if (page_data == nullptr) {
+            // Not sure the whole page is unreadable, fall back to a direct read, which will fail if
+            // this part of it actually is
+            return ::process_read(process, address, buf, size);
+        }
+
+        std::copy_n(page_data + (current - page), chunk_size, buf + offset);
+        current += chunk_size;
+        offset += chunk_size;
+    }
+    return true;
+}
+
+void PageCache::invalidate(void) {
+    this->generation++;
+}
+
+uint64_t PageCache::hits(void) const {
+    return this->hit_count;
+}
+
+uint64_t PageCache::misses(void) const {
+    return this->miss_count;
+}
+
+void PageCache::reset_stats(void) {
+    this->hit_count = 0;
+    this->miss_count = 0;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
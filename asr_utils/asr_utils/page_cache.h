@@ -0,0 +1,90 @@
+#ifndef ASR_UTILS_PAGE_CACHE_H
+#define ASR_UTILS_PAGE_CACHE_H
+
+#include "asr_utils/pch.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief A fixed size cache of remote memory pages.
+ * @note Intended to only live for a single tick - it never checks if memory changed, so it must be
+ *       invalidated at the start of every update.
+ */
+class PageCache {
+   private:
+    struct Slot {
+        Address page;
+        uint64_t generation;
+        bool readable;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint8_t> data;
+    uint64_t generation{1};
+    uint64_t hit_count{0};
+    uint64_t miss_count{0};
+
+    /**
+     * @brief Gets the cached contents of a page, reading it if not already cached.
+     *
+     * @param process The process to read memory of.
+     * @param page The address of the page.
+     * @return A pointer to the page's contents, or nullptr if it's unreadable.
+     */
+    const uint8_t* get_page(ProcessId process, Address page);
+
+   public:
+    static const constexpr size_t PAGE_SIZE = 0x1000;
+    static const constexpr size_t DEFAULT_CAPACITY = 64;
+    static const constexpr size_t MAX_PROBES = 8;
+
+    /**
+     * @brief Constructs a new page cache.
+     *
+     * @param capacity The amount of pages to cache. Rounded up to a power of two.
+     */
+    explicit PageCache(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Reads memory through the cache.
+     * @note Reads of a page or larger bypass the cache.
+     *
+     * @param process The process to read memory of.
+     * @param address The address to read memory at.
+     * @param buf The buffer to read into.
+     * @param size The amount of bytes to read.
+     * @return True on success, false on failure.
+     */
+    bool read(ProcessId process, Address address, uint8_t* buf, size_t size);
+
+    /**
+     * @brief Invalidates all cached pages.
+     * @note Doesn't free anything, this just bumps a generation counter.
+     */
+    void invalidate(void);
+
+    /**
+     * @brief Gets the amount of page lookups which were already cached.
+     *
+     * @return The number of hits.
+     */
+    [[nodiscard]] uint64_t hits(void) const;
+
+    /**
+     * @brief Gets the amount of page lookups which needed to read memory.
+     *
+     * @return The number of misses.
+     */
+    [[nodiscard]] uint64_t misses(void) const;
+
+    /**
+     * @brief Resets the hit and miss counters.
+     */
+    void reset_stats(void);
+};
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_PAGE_CACHE_H */
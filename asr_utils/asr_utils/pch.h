@@ -5,17 +5,29 @@
 
 #ifdef __cplusplus
 
+#include <algorithm>
 #include <array>
 #include <bit>
+#include <cassert>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <format>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 using std::int16_t;
 using std::int32_t;
@@ -1,29 +1,243 @@
 #include "asr_utils/pch.h"
 #include "asr_utils/pointer.h"
 #include "asr_utils/read_mem.h"
+#include "asr_utils/typed_process.h"
 
 namespace asr_utils {
 inline namespace v0 {
 
 Address DeepPointer::dereference(const ProcessInfo& process) const {
-    auto addr = read_address(process, this->base);
-    if (this->offsets.empty()) {
-        return addr;
+    return with_typed_process(process,
+                              [this](const auto& typed) { return this->dereference(typed); });
+}
+
+void PointerFailureCache::record_walk(bool success,
+                                      size_t level,
+                                      Address addr,
+                                      Address parent_addr) {
+    if (success) {
+        this->reset();
+        return;
+    }
+
+    // Failing in the same place again means we're probably still on a loading screen, back off
+    if (this->failing && this->failed_level == level && this->failed_addr == addr) {
+        this->backoff = std::min(this->backoff * 2, MAX_BACKOFF);
+    } else {
+        this->backoff = 1;
+    }
+
+    this->failing = true;
+    this->failed_level = level;
+    this->failed_addr = addr;
+    this->parent_addr = parent_addr;
+    this->ticks_until_retry = this->backoff;
+}
+
+void PointerFailureCache::reset(void) {
+    this->failing = false;
+    this->failed_level = 0;
+    this->failed_addr = 0;
+    this->parent_addr = 0;
+    this->backoff = 0;
+    this->ticks_until_retry = 0;
+}
+
+uint64_t PointerFailureCache::num_reads_avoided(void) const {
+    return this->reads_avoided;
+}
+
+uint64_t PointerFailureCache::num_short_circuits(void) const {
+    return this->short_circuits;
+}
+
+Address DeepPointer::dereference(const ProcessInfo& process, PointerFailureCache& cache) const {
+    return with_typed_process(process, [this, &cache](const auto& typed) {
+        return this->dereference_typed(typed, cache);
+    });
+}
+
+template <typename PointerT, std::endian endian>
+Address DeepPointer::dereference_typed(const TypedProcess<PointerT, endian>& process,
+                                       PointerFailureCache& cache) const {
+    if (cache.failing && cache.ticks_until_retry > 0) {
+        cache.ticks_until_retry--;
+
+        // If the level above still points at the same place, and the level which failed is still
+        // null, assume everything before them is unchanged. The base has no level above it.
+        auto parent_unchanged =
+            cache.failed_level == 0
+            || (cache.failed_level <= this->offsets.size()
+                && process.read_address(cache.parent_addr) + this->offsets[cache.failed_level - 1]
+                       == cache.failed_addr);
+        if (parent_unchanged && process.read_address(cache.failed_addr) == 0) {
+            cache.reads_avoided += cache.failed_level > 0 ? cache.failed_level - 1 : 0;
+            cache.short_circuits++;
+            return 0;
+        }
     }
 
+    auto addr = process.read_address(this->base);
     if (addr == 0) {
+        cache.record_walk(false, 0, this->base);
         return 0;
     }
+    if (this->offsets.empty()) {
+        cache.record_walk(true);
+        return addr;
+    }
 
+    auto parent_addr = this->base;
     for (size_t i = 0; i < (this->offsets.size() - 1); i++) {
-        addr = read_address(process, addr + this->offsets[i]);
+        auto level_addr = addr + this->offsets[i];
+        addr = process.read_address(level_addr);
         if (addr == 0) {
+            cache.record_walk(false, i + 1, level_addr, parent_addr);
             return 0;
         }
+        parent_addr = level_addr;
     }
 
+    cache.record_walk(true);
     return addr + this->offsets.back();
 }
 
+/*
+A path with n offsets takes n reads: the base, then every offset but the last. We store the result
+of each read in `levels`, so level i is the address read using offset i - 1 (or the base, for level
+0). Re-reading the last K levels means starting from the cached level before them.
+*/
+
+CachedDeepPointer::CachedDeepPointer(DeepPointer ptr,
+                                     size_t reread_levels,
+                                     size_t revalidate_interval)
+    : ptr(std::move(ptr)),
+      reread_levels(std::max<size_t>(reread_levels, 1)),
+      revalidate_interval(revalidate_interval) {}
+
+template <typename PointerT, std::endian endian>
+Address CachedDeepPointer::walk_from(const TypedProcess<PointerT, endian>& process, size_t start) {
+    auto num_levels = std::max<size_t>(this->ptr.offsets.size(), 1);
+    this->levels.resize(num_levels);
+
+    for (size_t i = start; i < num_levels; i++) {
+        auto addr = i == 0 ? process.read_address(this->ptr.base)
+                           : process.read_address(this->levels[i - 1] + this->ptr.offsets[i - 1]);
+        if (addr == 0) {
+            this->valid_levels = i;
+            return 0;
+        }
+        this->levels[i] = addr;
+    }
+
+    this->valid_levels = num_levels;
+    return this->levels.back() + (this->ptr.offsets.empty() ? 0 : this->ptr.offsets.back());
+}
+
+Address CachedDeepPointer::dereference(const ProcessInfo& process) {
+    return with_typed_process(process,
+                              [this](const auto& typed) { return this->dereference_typed(typed); });
+}
+
+template <typename PointerT, std::endian endian>
+Address CachedDeepPointer::dereference_typed(const TypedProcess<PointerT, endian>& process) {
+    auto num_levels = std::max<size_t>(this->ptr.offsets.size(), 1);
+    auto start = num_levels - std::min(this->reread_levels, num_levels);
+
+    // Only need the level before the ones we re-read to be valid, later ones get overwritten
+    if (start > 0 && this->valid_levels >= start
+        && this->ticks_since_full_walk < this->revalidate_interval) {
+        this->ticks_since_full_walk++;
+
+        auto first = process.read_address(this->levels[start - 1] + this->ptr.offsets[start - 1]);
+        if (first != 0) {
+            this->levels[start] = first;
+            this->reads_saved += start;
+            return this->walk_from(process, start + 1);
+        }
+    }
+
+    this->ticks_since_full_walk = 0;
+    return this->walk_from(process, 0);
+}
+
+void CachedDeepPointer::invalidate(void) {
+    this->valid_levels = 0;
+}
+
+DeepPointer& CachedDeepPointer::pointer(void) {
+    this->invalidate();
+    return this->ptr;
+}
+
+uint64_t CachedDeepPointer::num_reads_saved(void) const {
+    return this->reads_saved;
+}
+
+size_t PointerTree::find_or_add_node(size_t parent, Address key) {
+    for (size_t i = 0; i < this->nodes.size(); i++) {
+        if (this->nodes[i].parent == parent && this->nodes[i].key == key) {
+            return i;
+        }
+    }
+    this->nodes.push_back({parent, key, 0});
+    return this->nodes.size() - 1;
+}
+
+PointerTree::Handle PointerTree::add(const DeepPointer& ptr) {
+    auto node = this->find_or_add_node(NO_PARENT, ptr.base);
+    if (ptr.offsets.empty()) {
+        this->leaves.push_back({node, 0});
+        return this->leaves.size() - 1;
+    }
+
+    // Every offset but the last is another read, the last just gets added on at the end
+    for (size_t i = 0; i < (ptr.offsets.size() - 1); i++) {
+        node = this->find_or_add_node(node, static_cast<Address>(ptr.offsets[i]));
+    }
+    this->leaves.push_back({node, ptr.offsets.back()});
+    return this->leaves.size() - 1;
+}
+
+void PointerTree::resolve(const ProcessInfo& process) {
+    with_typed_process(process, [this](const auto& typed) { this->resolve_typed(typed); });
+}
+
+template <typename PointerT, std::endian endian>
+void PointerTree::resolve_typed(const TypedProcess<PointerT, endian>& process) {
+    this->reads = 0;
+    for (auto& node : this->nodes) {
+        Address addr{};
+        if (node.parent == NO_PARENT) {
+            addr = node.key;
+        } else {
+            auto parent_value = this->nodes[node.parent].value;
+            if (parent_value == 0) {
+                node.value = 0;
+                continue;
+            }
+            addr = parent_value + node.key;
+        }
+
+        this->reads++;
+        node.value = process.read_address(addr);
+    }
+}
+
+Address PointerTree::get(Handle handle) const {
+    const auto& leaf = this->leaves[handle];
+    auto value = this->nodes[leaf.node].value;
+    return value == 0 ? 0 : value + leaf.offset;
+}
+
+void PointerTree::clear(void) {
+    this->nodes.clear();
+    this->leaves.clear();
+}
+
+size_t PointerTree::num_reads(void) const {
+    return this->reads;
+}
+
 }  // namespace v0
 }  // namespace asr_utils
@@ -3,6 +3,8 @@
 
 #include "asr_utils/pch.h"
 #include "asr_utils/process_info.h"
+#include "asr_utils/read_mem.h"
+#include "asr_utils/typed_process.h"
 
 namespace asr_utils {
 inline namespace v0 {
@@ -39,6 +41,175 @@ using RemotePointer32 = RemotePointer<uint32_t, T>;
 template <typename T>
 using RemotePointer64 = RemotePointer<uint64_t, T>;
 
+/**
+ * @brief Class for reading arrays out of a remote process, into a reusable buffer.
+ * @note Retains the process endianness.
+ * @note Reading the same size array every tick does no allocations after the first.
+ *
+ * @tparam PointerT The pointer type in the remote process, used when gathering.
+ * @tparam T The element type.
+ */
+template <typename PointerT, typename T>
+class RemoteArray {
+   private:
+    static_assert(std::is_trivially_copyable_v<T>, "array elements must be trivially copyable");
+
+    std::vector<T> values;
+    std::vector<PointerT> pointers;
+    std::vector<size_t> request_idxs;
+    std::vector<bool> valid_values;
+    ReadBatch batch{};
+
+   public:
+    /**
+     * @brief Reads a contiguous array of values, in a single read.
+     *
+     * @param process The process to read memory of.
+     * @param address The address of the start of the array.
+     * @param count The number of elements in the array.
+     * @return A view of the read values, valid until the next read. Empty if the read failed.
+     */
+    std::span<const T> read(const ProcessInfo& process, Address address, size_t count) {
+        this->values.resize(count);
+        if (!read_mem(process, address, reinterpret_cast<uint8_t*>(this->values.data()),
+                      count * sizeof(T))) {
+            this->values.clear();
+        }
+        this->valid_values.assign(this->values.size(), true);
+        return this->values;
+    }
+    std::span<const T> read(ProcessId process, Address address, size_t count) = delete;
+
+    /**
+     * @brief Reads an array of pointers, then gathers the values they each point to.
+     * @note The pointer array is a single read, while the values are sorted by address and read
+     *       using coalesced reads.
+     *
+     * @param process The process to read memory of.
+     * @param address The address of the start of the pointer array.
+     * @param count The number of pointers in the array.
+     * @return A view of the read values, valid until the next read. Empty if the pointer array
+     *         couldn't be read. Values which couldn't be read are default constructed, use `valid`
+     *         to check them.
+     */
+    std::span<const T> gather(const ProcessInfo& process, Address address, size_t count) {
+        this->pointers.resize(count);
+        if (!read_mem(process, address, reinterpret_cast<uint8_t*>(this->pointers.data()),
+                      count * sizeof(PointerT))) {
+            this->values.clear();
+            this->valid_values.clear();
+            return {};
+        }
+        fix_endianness(process, std::span{this->pointers});
+
+        this->values.assign(count, T{});
+        this->valid_values.assign(count, false);
+        this->request_idxs.assign(count, std::numeric_limits<size_t>::max());
+
+        this->batch.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (this->pointers[i] != 0) {
+                this->request_idxs[i] = this->batch.add(this->pointers[i], this->values[i]);
+            }
+        }
+        this->batch.execute(process);
+
+        for (size_t i = 0; i < count; i++) {
+            if (this->request_idxs[i] == std::numeric_limits<size_t>::max()) {
+                continue;
+            }
+            if (this->batch.succeeded(this->request_idxs[i])) {
+                this->valid_values[i] = true;
+            } else {
+                this->values[i] = T{};
+            }
+        }
+
+        return this->values;
+    }
+    std::span<const T> gather(ProcessId process, Address address, size_t count) = delete;
+
+    /**
+     * @brief Checks if a value was read successfully.
+     * @note Always true after a successful contiguous read. Null pointers are never valid.
+     *
+     * @param idx The index of the value.
+     * @return True if the value is valid.
+     */
+    [[nodiscard]] bool valid(size_t idx) const {
+        return idx < this->valid_values.size() && this->valid_values[idx];
+    }
+
+    /**
+     * @brief Gets the values from the last read.
+     *
+     * @return A view of the values.
+     */
+    [[nodiscard]] std::span<const T> current(void) const { return this->values; }
+};
+
+template <typename T>
+using RemoteArray32 = RemoteArray<uint32_t, T>;
+template <typename T>
+using RemoteArray64 = RemoteArray<uint64_t, T>;
+
+/**
+ * @brief Remembers where a pointer path last failed, so that repeated failures are cheap.
+ * @note While the path keeps failing at the same place, dereferencing only re-reads the level
+ *       which failed and the level above it, rather than walking the whole path. If the level above
+ *       no longer points at the failed address, it walks the full path straight away.
+ * @note Changes further up the path than the level above the failure aren't noticed until the
+ *       next full walk, which are retried with exponential backoff.
+ */
+class PointerFailureCache {
+   private:
+    friend struct DeepPointer;
+
+    bool failing{false};
+    size_t failed_level{0};
+    // The address which read back 0, i.e. the parent level's value plus the offset
+    Address failed_addr{0};
+    // The address the parent level's value was read from, unused if the base failed
+    Address parent_addr{0};
+    size_t backoff{0};
+    size_t ticks_until_retry{0};
+
+    uint64_t reads_avoided{0};
+    uint64_t short_circuits{0};
+
+    /**
+     * @brief Records the result of a full walk.
+     *
+     * @param success True if the walk succeeded.
+     * @param level The level which failed, if it didn't succeed.
+     * @param addr The address which read back 0, if it didn't succeed.
+     * @param parent_addr The address the parent level was read from, if it didn't succeed.
+     */
+    void record_walk(bool success, size_t level = 0, Address addr = 0, Address parent_addr = 0);
+
+   public:
+    static const constexpr size_t MAX_BACKOFF = 64;
+
+    /**
+     * @brief Forgets any remembered failure, so that the next dereference walks the full path.
+     */
+    void reset(void);
+
+    /**
+     * @brief Gets the amount of reads avoided by short-circuiting failing walks.
+     *
+     * @return The number of reads avoided.
+     */
+    [[nodiscard]] uint64_t num_reads_avoided(void) const;
+
+    /**
+     * @brief Gets the amount of dereferences which were short-circuited.
+     *
+     * @return The number of short-circuited dereferences.
+     */
+    [[nodiscard]] uint64_t num_short_circuits(void) const;
+};
+
 /**
  * @brief Class representing a multi-step pointer path.
  */
@@ -54,6 +225,254 @@ struct DeepPointer {
      */
     [[nodiscard]] Address dereference(const ProcessInfo& process) const;
     [[nodiscard]] Address dereference(ProcessId process) const = delete;
+    template <typename PointerT, std::endian endian>
+    [[nodiscard]] Address dereference(const TypedProcess<PointerT, endian>& process) const {
+        return process.dereference(this->base, this->offsets);
+    }
+
+    /**
+     * @brief Dereferences the pointer path, short-circuiting while it fails at the same place.
+     *
+     * @param process The process to read the pointer pat in.
+     * @param cache The failure cache to use for this path.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    [[nodiscard]] Address dereference(const ProcessInfo& process, PointerFailureCache& cache) const;
+    [[nodiscard]] Address dereference(ProcessId process, PointerFailureCache& cache) const = delete;
+
+   private:
+    /**
+     * @brief Dereferences the pointer path, short-circuiting while it fails at the same place.
+     *
+     * @param process The typed view of the process to read the pointer path in.
+     * @param cache The failure cache to use for this path.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    template <typename PointerT, std::endian endian>
+    Address dereference_typed(const TypedProcess<PointerT, endian>& process,
+                              PointerFailureCache& cache) const;
+};
+
+/**
+ * @brief A multi-step pointer path with a fixed number of offsets.
+ * @note Unlike `DeepPointer` this never allocates, can be constructed at compile time, and has a
+ *       fully unrolled dereference.
+ *
+ * @tparam N The number of offsets.
+ */
+template <size_t N>
+struct StaticDeepPointer {
+    Address base{};
+    std::array<ptrdiff_t, N> offsets{};
+
+    constexpr StaticDeepPointer(void) = default;
+    /**
+     * @brief Constructs a new static pointer path.
+     *
+     * @param base The address to start at.
+     * @param offsets The offsets to follow.
+     */
+    constexpr StaticDeepPointer(Address base, const ptrdiff_t (&offsets)[N])  // NOLINT(*-c-arrays)
+        : base(base) {
+        std::copy_n(&offsets[0], N, this->offsets.begin());
+    }
+
+    /**
+     * @brief Dereferences the pointer path.
+     *
+     * @param process The process to read the pointer pat in.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    [[nodiscard]] Address dereference(const ProcessInfo& process) const {
+        return with_typed_process(process,
+                                  [this](const auto& typed) { return this->dereference(typed); });
+    }
+    [[nodiscard]] Address dereference(ProcessId process) const = delete;
+    template <typename PointerT, std::endian endian>
+    [[nodiscard]] Address dereference(const TypedProcess<PointerT, endian>& process) const {
+        auto addr = process.read_address(this->base);
+        if constexpr (N == 0) {
+            return addr;
+        } else {
+            auto valid = [&]<size_t... i>(std::index_sequence<i...>) {
+                return addr != 0
+                       && (((addr = process.read_address(addr + this->offsets[i])) != 0) && ...);
+            }(std::make_index_sequence<N - 1>{});
+            return valid ? addr + this->offsets.back() : 0;
+        }
+    }
+};
+template <size_t N>
+StaticDeepPointer(Address, const ptrdiff_t (&)[N])  // NOLINT(*-c-arrays)
+    -> StaticDeepPointer<N>;
+
+/**
+ * @brief A pointer path which caches the intermediate addresses from it's last successful walk.
+ * @note Most dereferences only re-read the last few levels of the path, starting from the cached
+ *       address before them. The full path is periodically walked again, and whenever the first
+ *       level being re-read fails or reads back 0.
+ */
+class CachedDeepPointer {
+   private:
+    DeepPointer ptr;
+    size_t reread_levels;
+    size_t revalidate_interval;
+
+    std::vector<Address> levels;
+    size_t valid_levels{0};
+    size_t ticks_since_full_walk{0};
+    uint64_t reads_saved{0};
+
+    /**
+     * @brief Walks the path from the given level, storing the intermediate addresses.
+     * @note Assumes all levels before the start are valid.
+     *
+     * @param process The typed view of the process to read the pointer path in.
+     * @param start The level to start reading from.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    template <typename PointerT, std::endian endian>
+    Address walk_from(const TypedProcess<PointerT, endian>& process, size_t start);
+
+    /**
+     * @brief Dereferences the pointer path, using the cached intermediate levels if possible.
+     *
+     * @param process The typed view of the process to read the pointer path in.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    template <typename PointerT, std::endian endian>
+    Address dereference_typed(const TypedProcess<PointerT, endian>& process);
+
+   public:
+    static const constexpr size_t DEFAULT_REREAD_LEVELS = 2;
+    static const constexpr size_t DEFAULT_REVALIDATE_INTERVAL = 120;
+
+    /**
+     * @brief Constructs a new cached pointer path.
+     *
+     * @param ptr The pointer path.
+     * @param reread_levels The amount of levels, from the end of the path, to re-read every time.
+     * @param revalidate_interval The amount of dereferences between full walks of the path.
+     */
+    CachedDeepPointer(DeepPointer ptr,
+                      size_t reread_levels = DEFAULT_REREAD_LEVELS,
+                      size_t revalidate_interval = DEFAULT_REVALIDATE_INTERVAL);
+
+    /**
+     * @brief Dereferences the pointer path, using the cached intermediate levels if possible.
+     *
+     * @param process The process to read the pointer path in.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    [[nodiscard]] Address dereference(const ProcessInfo& process);
+    [[nodiscard]] Address dereference(ProcessId process) = delete;
+
+    /**
+     * @brief Forgets the cached levels, so that the next dereference walks the full path.
+     */
+    void invalidate(void);
+
+    /**
+     * @brief Gets the underlying pointer path.
+     * @note The cache is invalidated, since the caller may edit the path.
+     *
+     * @return The deep pointer.
+     */
+    [[nodiscard]] DeepPointer& pointer(void);
+
+    /**
+     * @brief Gets the amount of reads which were skipped by using cached levels.
+     *
+     * @return The number of reads saved.
+     */
+    [[nodiscard]] uint64_t num_reads_saved(void) const;
+};
+
+/**
+ * @brief Resolves many pointer paths at once, reading any levels they share only once.
+ * @note Paths are merged into a trie keyed on their base and offsets, so e.g. twenty paths all
+ *       starting from the same global and first few offsets only read those levels once per tick.
+ */
+class PointerTree {
+   public:
+    using Handle = size_t;
+
+   private:
+    static const constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        size_t parent;
+        // The base address for root nodes, or the offset from the parent's value for others
+        Address key;
+        Address value;
+    };
+    struct Leaf {
+        size_t node;
+        ptrdiff_t offset;
+    };
+
+    // Parents are always added before their children
+    std::vector<Node> nodes;
+    std::vector<Leaf> leaves;
+    size_t reads{0};
+
+    /**
+     * @brief Finds or adds a node.
+     *
+     * @param parent The index of the parent node, or NO_PARENT for a root.
+     * @param key The base address, or offset from the parent.
+     * @return The index of the node.
+     */
+    size_t find_or_add_node(size_t parent, Address key);
+
+    /**
+     * @brief Resolves all paths in the tree.
+     *
+     * @param process The typed view of the process to read the pointer paths in.
+     */
+    template <typename PointerT, std::endian endian>
+    void resolve_typed(const TypedProcess<PointerT, endian>& process);
+
+   public:
+    /**
+     * @brief Adds a pointer path to the tree.
+     *
+     * @param ptr The pointer path.
+     * @return A handle used to get the path's resolved address.
+     */
+    Handle add(const DeepPointer& ptr);
+    template <size_t N>
+    Handle add(const StaticDeepPointer<N>& ptr) {
+        return this->add(DeepPointer{ptr.base, {ptr.offsets.begin(), ptr.offsets.end()}});
+    }
+
+    /**
+     * @brief Resolves all paths in the tree.
+     *
+     * @param process The process to read the pointer paths in.
+     */
+    void resolve(const ProcessInfo& process);
+    void resolve(ProcessId process) = delete;
+
+    /**
+     * @brief Gets the address a path resolved to during the last call to `resolve`.
+     *
+     * @param handle The handle returned when adding the path.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    [[nodiscard]] Address get(Handle handle) const;
+
+    /**
+     * @brief Removes all paths from the tree, invalidating all existing handles.
+     */
+    void clear(void);
+
+    /**
+     * @brief Gets the number of reads done by the last call to `resolve`.
+     *
+     * @return The number of reads.
+     */
+    [[nodiscard]] size_t num_reads(void) const;
 };
 
 }  // namespace v0
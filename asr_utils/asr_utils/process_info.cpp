@@ -20,7 +20,10 @@ point to wine instead.
 */
 
 const constexpr auto DOS_HEADER_MAGIC_LFA_NEW_PADDING = 0x3A;
-const constexpr auto NT_HEADER_MACHINE_SIZEOFIMAGE_PADDING = 0x4A;
+const constexpr auto NT_HEADER_CHARACTERISTICS_SIZEOFIMAGE_PADDING = 0x38;
+const constexpr auto NT_HEADER_OPTIONAL_HEADER_OFFSET = 0x18;
+const constexpr auto SECTION_HEADER_NAME_SIZE = 8;
+const constexpr auto SECTION_HEADER_RAW_DATA_CHARACTERISTICS_PADDING = 0xC;
 
 struct DOSHeader {
     uint8_t e_magic[2];
@@ -31,8 +34,26 @@ struct DOSHeader {
 struct NTHeader {
     uint8_t sig[4];
     uint16_t machine;
-    uint8_t padding[NT_HEADER_MACHINE_SIZEOFIMAGE_PADDING];
+    uint16_t number_of_sections;
+    uint32_t time_date_stamp;
+    uint32_t pointer_to_symbol_table;
+    uint32_t number_of_symbols;
+    uint16_t size_of_optional_header;
+    uint16_t characteristics;
+    uint8_t padding[NT_HEADER_CHARACTERISTICS_SIZEOFIMAGE_PADDING];
     uint32_t size_of_image;
+    uint32_t size_of_headers;
+    uint32_t checksum;
+};
+
+struct SectionHeader {
+    char name[SECTION_HEADER_NAME_SIZE];
+    uint32_t virtual_size;
+    uint32_t virtual_address;
+    uint32_t size_of_raw_data;
+    uint32_t pointer_to_raw_data;
+    uint8_t padding[SECTION_HEADER_RAW_DATA_CHARACTERISTICS_PADDING];
+    uint32_t characteristics;
 };
 
 const constexpr auto DOS_HEADER_MAGIC = "MZ";
@@ -41,6 +62,9 @@ const constexpr auto NT_HEADER_SIG = "PE\0\0";
 const constexpr auto IMAGE_FILE_MACHINE_I386 = 0x14C;
 const constexpr auto IMAGE_FILE_MACHINE_AMD64 = 0x8664;
 
+const constexpr auto IMAGE_SCN_CNT_CODE = 0x20;
+const constexpr auto IMAGE_SCN_MEM_EXECUTE = 0x20000000;
+
 const constexpr auto PROTON_INVALID_MAIN_MODULE_SIZE = 0x1000;
 
 }  // namespace
@@ -89,8 +113,19 @@ bool ProcessInfo::try_parse_pe(ProcessInfo::InitFlags init) {
 
     if (std::endian::native != std::endian::little) {
         nt_header.machine = swap_endianness(nt_header.machine);
+        nt_header.number_of_sections = swap_endianness(nt_header.number_of_sections);
+        nt_header.time_date_stamp = swap_endianness(nt_header.time_date_stamp);
+        nt_header.size_of_optional_header = swap_endianness(nt_header.size_of_optional_header);
+        nt_header.checksum = swap_endianness(nt_header.checksum);
     }
 
+    this->pe_timestamp = nt_header.time_date_stamp;
+    this->pe_checksum = nt_header.checksum;
+
+    this->try_parse_pe_sections(main_module + dos.e_lfa_new + NT_HEADER_OPTIONAL_HEADER_OFFSET
+                                    + nt_header.size_of_optional_header,
+                                nt_header.number_of_sections);
+
     if (nt_header.machine == IMAGE_FILE_MACHINE_AMD64) {
         this->is_64_bit = true;
         this->endianness = std::endian::little;
@@ -106,6 +141,45 @@ bool ProcessInfo::try_parse_pe(ProcessInfo::InitFlags init) {
     return false;
 }
 
+void ProcessInfo::try_parse_pe_sections(Address section_table, size_t num_sections) {
+    std::vector<SectionHeader> headers(num_sections);
+    if (!process_read(this->pid, section_table, reinterpret_cast<uint8_t*>(headers.data()),
+                      headers.size() * sizeof(SectionHeader))) {
+        runtime_print_message("Failed to read PE section table");
+        return;
+    }
+
+    this->sections.clear();
+    this->sections.reserve(num_sections);
+    for (auto& header : headers) {
+        if (std::endian::native != std::endian::little) {
+            header.virtual_size = swap_endianness(header.virtual_size);
+            header.virtual_address = swap_endianness(header.virtual_address);
+            header.size_of_raw_data = swap_endianness(header.size_of_raw_data);
+            header.pointer_to_raw_data = swap_endianness(header.pointer_to_raw_data);
+            header.characteristics = swap_endianness(header.characteristics);
+        }
+
+        // Names are only null terminated if shorter than the max length
+        std::string_view name{&header.name[0], sizeof(header.name)};
+        name = name.substr(0, name.find('\0'));
+
+        this->sections.push_back({std::string{name}, header.virtual_address, header.virtual_size,
+                                  header.pointer_to_raw_data, header.size_of_raw_data,
+                                  header.characteristics});
+    }
+}
+
+bool ProcessInfo::Section::is_executable(void) const {
+    return (this->characteristics & (IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE)) != 0;
+}
+
+const ProcessInfo::Section* ProcessInfo::find_section(std::string_view name) const {
+    auto section = std::find_if(this->sections.begin(), this->sections.end(),
+                                [name](const Section& section) { return section.name == name; });
+    return section == this->sections.end() ? nullptr : &*section;
+}
+
 namespace {
 
 struct ELFHeader {
@@ -190,5 +264,15 @@ ProcessInfo::operator ProcessId() const {
     return this->pid;
 }
 
+void ProcessInfo::enable_page_cache(size_t capacity) {
+    this->page_cache = std::make_shared<PageCache>(capacity);
+}
+
+void ProcessInfo::invalidate_page_cache(void) const {
+    if (this->page_cache) {
+        this->page_cache->invalidate();
+    }
+}
+
 }  // namespace v0
 }  // namespace asr_utils
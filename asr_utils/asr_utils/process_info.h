@@ -2,6 +2,7 @@
 #define ASR_UTILS_PROCESS_INFO_H
 
 #include "asr_utils/pch.h"
+#include "asr_utils/page_cache.h"
 
 namespace asr_utils {
 inline namespace v0 {
@@ -17,6 +18,22 @@ struct ProcessInfo {
         ELF
     };
 
+    struct Section {
+        std::string name;
+        Address rva;
+        size_t size;
+        size_t raw_offset;
+        size_t raw_size;
+        uint32_t characteristics;
+
+        /**
+         * @brief Checks if this section contains executable code.
+         *
+         * @return True if the section is executable.
+         */
+        [[nodiscard]] bool is_executable(void) const;
+    };
+
     ProcessId pid{0};
     Address main_module{};
     size_t main_module_size{};
@@ -24,6 +41,11 @@ struct ProcessInfo {
     bool is_64_bit{false};
     std::endian endianness{std::endian::little};
     ExecutableFormat exe_format{ExecutableFormat::UNKNOWN};
+    uint32_t pe_timestamp{0};
+    uint32_t pe_checksum{0};
+    std::vector<Section> sections{};
+    // Shared between copies, since they all refer to the same process. Null if disabled.
+    std::shared_ptr<PageCache> page_cache{};
 
     /**
      * @brief Construct a new Process Info object
@@ -43,6 +65,29 @@ struct ProcessInfo {
      */
     operator ProcessId(void) const;
 
+    /**
+     * @brief Finds a section of the main module by name.
+     * @note Only valid for the lifetime of this object.
+     *
+     * @param name The name of the section, e.g. `.text`.
+     * @return A pointer to the section, or nullptr if it doesn't exist.
+     */
+    [[nodiscard]] const Section* find_section(std::string_view name) const;
+
+    /**
+     * @brief Enables caching reads from this process, a page at a time.
+     * @note Used by `read_mem`, `read_address` and `read_string`.
+     * @note The cache must be invalidated at the start of every tick.
+     *
+     * @param capacity The amount of pages to cache.
+     */
+    void enable_page_cache(size_t capacity = PageCache::DEFAULT_CAPACITY);
+
+    /**
+     * @brief Invalidates the page cache, if enabled.
+     */
+    void invalidate_page_cache(void) const;
+
     ProcessInfo(void) = default;
     ProcessInfo(const ProcessInfo& other) = default;
     ProcessInfo(ProcessInfo&& other) noexcept = default;
@@ -59,6 +104,14 @@ struct ProcessInfo {
      */
     bool try_parse_pe(InitFlags init);
 
+    /**
+     * @brief Tries to parse a PE section table, and fills this object's section list with it.
+     *
+     * @param section_table The address of the section table.
+     * @param num_sections The number of sections in the table.
+     */
+    void try_parse_pe_sections(Address section_table, size_t num_sections);
+
     /**
      * @brief Tries to parse an ELF header, and fills this object with it's details.
      *
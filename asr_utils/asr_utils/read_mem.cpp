@@ -1,28 +1,95 @@
 #include "asr_utils/pch.h"
 #include "asr_utils/read_mem.h"
 #include "asr_utils/asr_extensions.h"
+#include "asr_utils/typed_process.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
 
 namespace asr_utils {
 inline namespace v0 {
 
 namespace {
 
+/*
+Bulk endianness swaps work a whole simd vector at a time, shuffling the bytes of each element into
+reverse order, then finish off any remainder one element at a time.
+*/
+
+/**
+ * @brief Swaps the endianness of each element of a buffer, in place.
+ *
+ * @tparam T An unsigned integer type the size of each element.
+ * @param data The buffer to swap.
+ * @param count The number of elements in the buffer.
+ */
 template <typename T>
-Address read_address(const ProcessInfo& process, Address address) {
-    auto new_addr = read_mem<T>(process, address);
-    return std::endian::native != process.endianness ? swap_endianness(new_addr) : new_addr;
+void swap_endianness_elements(uint8_t* data, size_t count) {
+    size_t idx = 0;
+
+#ifdef __wasm_simd128__
+    // NOLINTBEGIN(readability-magic-numbers)
+    const auto per_vector = sizeof(v128_t) / sizeof(T);
+    for (; idx + per_vector <= count; idx += per_vector) {
+        auto* ptr = &data[idx * sizeof(T)];
+        auto vec = wasm_v128_load(ptr);
+        if constexpr (sizeof(T) == sizeof(uint16_t)) {
+            vec = wasm_i8x16_shuffle(vec, vec, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15,
+                                     14);
+        } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+            vec = wasm_i8x16_shuffle(vec, vec, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13,
+                                     12);
+        } else {
+            vec = wasm_i8x16_shuffle(vec, vec, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9,
+                                     8);
+        }
+        wasm_v128_store(ptr, vec);
+    }
+    // NOLINTEND(readability-magic-numbers)
+#endif
+
+    for (; idx < count; idx++) {
+        T val{};
+        memcpy(&val, &data[idx * sizeof(T)], sizeof(T));
+        val = swap_endianness(val);
+        memcpy(&data[idx * sizeof(T)], &val, sizeof(T));
+    }
 }
 
 }  // namespace
 
+void swap_endianness_elements(uint8_t* data, size_t count, size_t element_size) {
+    switch (element_size) {
+        case sizeof(uint16_t):
+            swap_endianness_elements<uint16_t>(data, count);
+            break;
+        case sizeof(uint32_t):
+            swap_endianness_elements<uint32_t>(data, count);
+            break;
+        case sizeof(uint64_t):
+            swap_endianness_elements<uint64_t>(data, count);
+            break;
+        default:
+            break;
+    }
+}
+
+bool read_mem(const ProcessInfo& process, Address address, uint8_t* buf, size_t size) {
+    if (process.page_cache) {
+        return process.page_cache->read(process, address, buf, size);
+    }
+    return ::process_read(process, address, buf, size);
+}
+
 Address read_address(const ProcessInfo& process, Address address) {
-    return process.is_64_bit ? read_address<uint64_t>(process, address)
-                             : read_address<uint32_t>(process, address);
+    return with_typed_process(process,
+                              [address](const auto& typed) { return typed.read_address(address); });
 }
 
 Address read_x86_offset(const ProcessInfo& process, Address address) {
-    return process.is_64_bit ? read_x86_offset64(process, address)
-                             : read_x86_offset32(process, address);
+    return with_typed_process(
+        process, [address](const auto& typed) { return typed.read_x86_offset(address); });
 }
 
 static_assert(std::endian::native == std::endian::little);
@@ -44,5 +111,98 @@ Address read_x86_offset64(ProcessId process, Address address) {
     return address + static_cast<Address>(offset) + sizeof(offset);
 }
 
+/*
+To execute a batch, we sort the requests by address, then walk through them growing a merged range
+while the next request starts within the allowed gap of the current end. Each merged range is a
+single host read into a scratch buffer, which we then copy out of.
+
+If a merged read fails, we can't tell which part of it was unreadable, so we fall back to reading
+each request in the group individually, so that every request still gets an accurate result.
+*/
+
+ReadBatch::ReadBatch(size_t max_gap) : max_gap(max_gap) {}
+
+size_t ReadBatch::add(Address address, uint8_t* dest, size_t size) {
+    this->requests.push_back({address, dest, size, false});
+    return this->requests.size() - 1;
+}
+
+void ReadBatch::execute_individually(ProcessId process, size_t begin, size_t end) {
+    for (auto idx = begin; idx < end; idx++) {
+        auto& request = this->requests[this->order[idx]];
+        request.success = process_read(process, request.address, request.dest, request.size);
+        this->last_host_reads++;
+    }
+}
+
+bool ReadBatch::execute(ProcessId process) {
+    this->last_host_reads = 0;
+
+    this->order.resize(this->requests.size());
+    std::iota(this->order.begin(), this->order.end(), 0);
+    std::sort(this->order.begin(), this->order.end(), [this](size_t lhs, size_t rhs) {
+        return this->requests[lhs].address < this->requests[rhs].address;
+    });
+
+    bool all_success = true;
+    size_t group_begin = 0;
+    while (group_begin < this->order.size()) {
+        const auto& first = this->requests[this->order[group_begin]];
+        Address group_start = first.address;
+        Address group_end = first.address + first.size;
+
+        auto group_end_idx = group_begin + 1;
+        for (; group_end_idx < this->order.size(); group_end_idx++) {
+            const auto& next = this->requests[this->order[group_end_idx]];
+            auto next_end = std::max(group_end, next.address + next.size);
+            if (next.address > group_end + this->max_gap
+                || next_end - group_start > MAX_MERGED_SIZE) {
+                break;
+            }
+            group_end = next_end;
+        }
+
+        if (group_end_idx - group_begin == 1) {
+            this->execute_individually(process, group_begin, group_end_idx);
+        } else {
+            this->buffer.resize(group_end - group_start);
+            this->last_host_reads++;
+            if (process_read(process, group_start, this->buffer.data(), this->buffer.size())) {
+                for (auto idx = group_begin; idx < group_end_idx; idx++) {
+                    auto& request = this->requests[this->order[idx]];
+                    std::copy_n(this->buffer.data() + (request.address - group_start),
+                                request.size, request.dest);
+                    request.success = true;
+                }
+            } else {
+                this->execute_individually(process, group_begin, group_end_idx);
+            }
+        }
+
+        for (auto idx = group_begin; idx < group_end_idx; idx++) {
+            all_success &= this->requests[this->order[idx]].success;
+        }
+        group_begin = group_end_idx;
+    }
+
+    return all_success;
+}
+
+bool ReadBatch::succeeded(size_t idx) const {
+    return idx < this->requests.size() && this->requests[idx].success;
+}
+
+size_t ReadBatch::host_reads(void) const {
+    return this->last_host_reads;
+}
+
+size_t ReadBatch::size(void) const {
+    return this->requests.size();
+}
+
+void ReadBatch::clear(void) {
+    this->requests.clear();
+}
+
 }  // namespace v0
 }  // namespace asr_utils
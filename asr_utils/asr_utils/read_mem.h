@@ -25,6 +25,35 @@ T swap_endianness(T val) {
     return buf.val;
 }
 
+/**
+ * @brief Swaps the endianness of each element of a buffer, in place.
+ * @note Uses simd when available.
+ *
+ * @param data The buffer to swap.
+ * @param count The number of elements in the buffer.
+ * @param element_size The size of each element. Must be 2, 4 or 8.
+ */
+void swap_endianness_elements(uint8_t* data, size_t count, size_t element_size);
+
+/**
+ * @brief Swaps the endianness of every value in a span, in place.
+ * @note Element sizes of 2, 4 and 8 are vectorised, others are swapped one at a time.
+ *
+ * @tparam T The type of the values.
+ * @param vals The values.
+ */
+template <typename T>
+void swap_endianness(std::span<T> vals) {
+    if constexpr (sizeof(T) == sizeof(uint16_t) || sizeof(T) == sizeof(uint32_t)
+                  || sizeof(T) == sizeof(uint64_t)) {
+        swap_endianness_elements(reinterpret_cast<uint8_t*>(vals.data()), vals.size(), sizeof(T));
+    } else if constexpr (sizeof(T) > 1) {
+        for (auto& val : vals) {
+            val = swap_endianness(val);
+        }
+    }
+}
+
 /**
  * @brief Ensures the provided value is in native endianness.
  * @note Swaps the endianness if the process endianness does not match the native endianness.
@@ -41,6 +70,35 @@ T fix_endianness(const ProcessInfo& process, T val) {
 template <typename T>
 T fix_endianness(ProcessId process, T val) = delete;
 
+/**
+ * @brief Ensures all the provided values are in native endianness, in place.
+ * @note Does nothing if the process endianness matches the native endianness.
+ *
+ * @tparam T The type of the values.
+ * @param process The process the values are from.
+ * @param vals The values.
+ */
+template <typename T>
+void fix_endianness(const ProcessInfo& process, std::span<T> vals) {
+    if (std::endian::native != process.endianness) {
+        swap_endianness(vals);
+    }
+}
+template <typename T>
+void fix_endianness(ProcessId process, std::span<T> vals) = delete;
+
+/**
+ * @brief Reads memory from a process, through it's page cache if enabled.
+ *
+ * @param process The process to read memory of.
+ * @param address The address to read memory at.
+ * @param buf The buffer to read into.
+ * @param size The amount of bytes to read.
+ * @return True on success, false on failure.
+ */
+bool read_mem(const ProcessInfo& process, Address address, uint8_t* buf, size_t size);
+bool read_mem(ProcessId process, Address address, uint8_t* buf, size_t size) = delete;
+
 /**
  * @brief Reads a value from a process.
  * @note Retains the process endianness.
@@ -53,7 +111,7 @@ T fix_endianness(ProcessId process, T val) = delete;
 template <typename T>
 T read_mem(const ProcessInfo& process, Address address) {
     T val{};
-    process_read(process, address, val);
+    read_mem(process, address, reinterpret_cast<uint8_t*>(&val), sizeof(T));
     return val;
 }
 template <typename T>
@@ -82,8 +140,108 @@ Address read_x86_offset(ProcessId process, Address address) = delete;
 Address read_x86_offset32(ProcessId process, Address address);
 Address read_x86_offset64(ProcessId process, Address address);
 
+const constexpr size_t READ_STRING_DEFAULT_MAX_CHARS = 256;
+const constexpr size_t READ_STRING_INITIAL_CHUNK_SIZE = 0x40;
+const constexpr Address READ_STRING_PAGE_SIZE = 0x1000;
+
+/**
+ * @brief Reads a null terminated string into an existing string, using a custom read function.
+ * @note Reads in growing chunks until it finds the terminator. If a chunk fails to read, retries
+ *       reading only up to the next page boundary, so strings right before unmapped memory still
+ *       work.
+ *
+ * @tparam CharT The string's character type.
+ * @tparam Traits The string's traits type.
+ * @tparam Allocator The string's allocator type.
+ * @tparam ReadFunc The read function type.
+ * @param read A function `bool(Address address, uint8_t* buf, size_t size)` to read memory with.
+ * @param address The address of the string to read.
+ * @param out The string to read into. Cleared on failure.
+ * @param max_chars The maximum length of the string to read, in characters. Longer strings are
+ *                  truncated.
+ * @return True on success, false on failure.
+ */
+template <typename CharT, typename Traits, typename Allocator, typename ReadFunc>
+bool read_string_into_with(ReadFunc&& read,
+                           Address address,
+                           std::basic_string<CharT, Traits, Allocator>& out,
+                           size_t max_chars) {
+    out.clear();
+
+    auto chunk_chars = READ_STRING_INITIAL_CHUNK_SIZE / sizeof(CharT);
+    while (out.size() < max_chars) {
+        auto start = out.size();
+        auto num_chars = std::min(chunk_chars, max_chars - start);
+        auto chunk_addr = address + (start * sizeof(CharT));
+
+        out.resize(start + num_chars);
+        if (!read(chunk_addr, reinterpret_cast<uint8_t*>(&out[start]), num_chars * sizeof(CharT))) {
+            auto page_chars = (READ_STRING_PAGE_SIZE - (chunk_addr % READ_STRING_PAGE_SIZE))
+                              / sizeof(CharT);
+            if (page_chars == 0 || page_chars >= num_chars
+                || !read(chunk_addr, reinterpret_cast<uint8_t*>(&out[start]),
+                         page_chars * sizeof(CharT))) {
+                out.clear();
+                return false;
+            }
+            num_chars = page_chars;
+            out.resize(start + num_chars);
+        }
+
+        const auto* terminator = Traits::find(&out[start], num_chars, CharT{});
+        if (terminator != nullptr) {
+            out.resize(terminator - out.data());
+            return true;
+        }
+
+        chunk_chars *= 2;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads a null terminated string into an existing string, reusing it's buffer.
+ * @note Reads in growing chunks until it finds the terminator. If a chunk fails to read, retries
+ *       reading only up to the next page boundary, so strings right before unmapped memory still
+ *       work.
+ *
+ * @tparam CharT The string's character type.
+ * @tparam Traits The string's traits type.
+ * @tparam Allocator The string's allocator type.
+ * @param process The process to read memory of.
+ * @param address The address of the string to read.
+ * @param out The string to read into. Cleared on failure.
+ * @param max_chars The maximum length of the string to read, in characters. Longer strings are
+ *                  truncated.
+ * @return True on success, false on failure.
+ */
+template <typename CharT, typename Traits, typename Allocator>
+bool read_string_into(ProcessId process,
+                      Address address,
+                      std::basic_string<CharT, Traits, Allocator>& out,
+                      size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) {
+    return read_string_into_with(
+        [process](Address addr, uint8_t* buf, size_t size) {
+            return ::process_read(process, addr, buf, size);
+        },
+        address, out, max_chars);
+}
+template <typename CharT, typename Traits, typename Allocator>
+bool read_string_into(const ProcessInfo& process,
+                      Address address,
+                      std::basic_string<CharT, Traits, Allocator>& out,
+                      size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) {
+    return read_string_into_with(
+        [&process](Address addr, uint8_t* buf, size_t size) {
+            return read_mem(process, addr, buf, size);
+        },
+        address, out, max_chars);
+}
+
 /**
  * @brief Reads a null terminated string.
+ * @note See `read_string_into` to avoid allocating a new string each call.
  *
  * @tparam CharT The string's character type.
  * @tparam Traits The string's traits type.
@@ -96,16 +254,117 @@ Address read_x86_offset64(ProcessId process, Address address);
 template <typename CharT = char,
           typename Traits = std::char_traits<CharT>,
           typename Allocator = std::allocator<CharT> >
-std::basic_string<CharT, Traits, Allocator> read_string(ProcessId process,
-                                                        Address address,
-                                                        // NOLINTNEXTLINE(readability-magic-numbers)
-                                                        size_t max_chars = 256) {
-    CharT buf[max_chars];
-    if (!process_read(process, address, reinterpret_cast<uint8_t*>(&buf[0]), sizeof(buf))) {
-        return {};
-    }
-    return {buf};
+std::basic_string<CharT, Traits, Allocator> read_string(
+    ProcessId process,
+    Address address,
+    size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) {
+    std::basic_string<CharT, Traits, Allocator> str{};
+    read_string_into(process, address, str, max_chars);
+    return str;
 }
+template <typename CharT = char,
+          typename Traits = std::char_traits<CharT>,
+          typename Allocator = std::allocator<CharT> >
+std::basic_string<CharT, Traits, Allocator> read_string(
+    const ProcessInfo& process,
+    Address address,
+    size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) {
+    std::basic_string<CharT, Traits, Allocator> str{};
+    read_string_into(process, address, str, max_chars);
+    return str;
+}
+
+/**
+ * @brief A batch of reads, which get combined into as few host calls as possible.
+ * @note Requests which are adjacent, overlapping, or within a small gap of each other get merged
+ *       into a single read, and then scattered back into their destinations.
+ * @note Destinations must stay valid until the batch is executed.
+ */
+class ReadBatch {
+   private:
+    struct Request {
+        Address address;
+        uint8_t* dest;
+        size_t size;
+        bool success;
+    };
+
+    size_t max_gap;
+    std::vector<Request> requests;
+    std::vector<size_t> order;
+    std::vector<uint8_t> buffer;
+    size_t last_host_reads{0};
+
+    /**
+     * @brief Reads each request in a merged group individually.
+     *
+     * @param process The process to read memory of.
+     * @param begin The first index in the sorted order to read.
+     * @param end One past the last index in the sorted order to read.
+     */
+    void execute_individually(ProcessId process, size_t begin, size_t end);
+
+   public:
+    static const constexpr size_t DEFAULT_MAX_GAP = 0x40;
+    static const constexpr size_t MAX_MERGED_SIZE = 0x10000;
+
+    /**
+     * @brief Constructs a new read batch.
+     *
+     * @param max_gap The largest gap between two requests which still merges them. Bytes in the gap
+     *                are read and thrown away, so this trades read size for number of reads.
+     */
+    explicit ReadBatch(size_t max_gap = DEFAULT_MAX_GAP);
+
+    /**
+     * @brief Adds a read to the batch.
+     *
+     * @param address The address to read memory at.
+     * @param dest The buffer to read into.
+     * @param size The amount of bytes to read.
+     * @return The index of the request, used to check if it succeeded.
+     */
+    size_t add(Address address, uint8_t* dest, size_t size);
+    template <typename T>
+    size_t add(Address address, T& val) {
+        return this->add(address, reinterpret_cast<uint8_t*>(&val), sizeof(T));
+    }
+
+    /**
+     * @brief Executes all requests in the batch.
+     *
+     * @param process The process to read memory of.
+     * @return True if all requests succeeded, false if any failed.
+     */
+    bool execute(ProcessId process);
+
+    /**
+     * @brief Checks if a request succeeded in the last execution.
+     *
+     * @param idx The index of the request, as returned by `add`.
+     * @return True if the request succeeded.
+     */
+    [[nodiscard]] bool succeeded(size_t idx) const;
+
+    /**
+     * @brief Gets the amount of host calls the last execution took.
+     *
+     * @return The number of host calls.
+     */
+    [[nodiscard]] size_t host_reads(void) const;
+
+    /**
+     * @brief Gets the amount of requests in the batch.
+     *
+     * @return The number of requests.
+     */
+    [[nodiscard]] size_t size(void) const;
+
+    /**
+     * @brief Removes all requests from the batch.
+     */
+    void clear(void);
+};
 
 }  // namespace v0
 }  // namespace asr_utils
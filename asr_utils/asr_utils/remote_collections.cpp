@@ -0,0 +1,67 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/remote_collections.h"
+#include "asr_utils/internal/hash.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+namespace {
+
+/*
+The walkers need to notice when they revisit a node, but a node based set would allocate on every
+insert, every tick. Instead this is a flat open addressed table, with linear probing, which keeps
+it's storage between walks. Since null links always end a walk, 0 can double as the empty marker.
+*/
+
+// NOLINTNEXTLINE(readability-magic-numbers)
+const constexpr size_t MIN_SLOTS = 16;
+
+}  // namespace
+
+void AddressSet::clear(size_t expected_size) {
+    // Keep the load factor under a half
+    auto size = std::bit_ceil(std::max(MIN_SLOTS, expected_size * 2));
+    if (size > this->slots.size()) {
+        this->slots.resize(size);
+    }
+    std::fill(this->slots.begin(), this->slots.end(), 0);
+    this->count = 0;
+}
+
+void AddressSet::grow(void) {
+    std::vector<Address> old_slots(std::max(MIN_SLOTS, this->slots.size() * 2), 0);
+    std::swap(old_slots, this->slots);
+
+    auto mask = this->slots.size() - 1;
+    for (auto addr : old_slots) {
+        if (addr == 0) {
+            continue;
+        }
+        auto idx = internal::hash_slot(addr, mask);
+        while (this->slots[idx] != 0) {
+            idx = (idx + 1) & mask;
+        }
+        this->slots[idx] = addr;
+    }
+}
+
+bool AddressSet::insert(Address addr) {
+    if ((this->count + 1) * 2 > this->slots.size()) {
+        this->grow();
+    }
+
+    auto mask = this->slots.size() - 1;
+    for (auto idx = internal::hash_slot(addr, mask);; idx = (idx + 1) & mask) {
+        if (this->slots[idx] == addr) {
+            return false;
+        }
+        if (this->slots[idx] == 0) {
+            this->slots[idx] = addr;
+            this->count++;
+            return true;
+        }
+    }
+}
+
+}  // namespace v0
+}  // namespace asr_utils
@@ -0,0 +1,371 @@
+#ifndef ASR_UTILS_REMOTE_COLLECTIONS_H
+#define ASR_UTILS_REMOTE_COLLECTIONS_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief A set of addresses, used to detect cycles while walking remote structures.
+ * @note Reuses it's storage between walks, so steady state use does no allocations.
+ */
+class AddressSet {
+   private:
+    std::vector<Address> slots;
+    size_t count{0};
+
+    /**
+     * @brief Doubles the capacity of the set, rehashing all existing entries.
+     */
+    void grow(void);
+
+   public:
+    /**
+     * @brief Removes all addresses from the set.
+     *
+     * @param expected_size The amount of addresses expected to be inserted.
+     */
+    void clear(size_t expected_size = 0);
+
+    /**
+     * @brief Inserts an address into the set.
+     *
+     * @param addr The address to insert. May not be 0.
+     * @return True if the address was inserted, false if it was already present.
+     */
+    bool insert(Address addr);
+};
+
+/**
+ * @brief Gets the address held in a remote link field.
+ *
+ * @tparam T The type of the field, either an integer or a `RemotePointer`.
+ * @param process The process the field was read from.
+ * @param link The field.
+ * @return The address it holds.
+ */
+template <typename T>
+Address remote_link_address(const ProcessInfo& process, const T& link) {
+    if constexpr (requires { link.addr; }) {
+        return static_cast<Address>(fix_endianness(process, link.addr));
+    } else {
+        return static_cast<Address>(fix_endianness(process, link));
+    }
+}
+
+/**
+ * @brief Reads nodes of a remote structure, prefetching those seen during the last walk.
+ * @note Nodes are prefetched using a `ReadBatch`, so if the structure didn't change, an entire walk
+ *       only costs a few coalesced reads. Nodes which weren't prefetched get read individually.
+ *
+ * @tparam Node The node type.
+ */
+template <typename Node>
+class RemoteNodeReader {
+   private:
+    static_assert(std::is_trivially_copyable_v<Node>, "nodes must be trivially copyable");
+
+    std::vector<Address> prefetched_addresses;
+    std::vector<Node> prefetched_nodes;
+    std::vector<size_t> prefetched_requests;
+    ReadBatch batch{};
+    size_t individual_reads{0};
+
+   public:
+    /**
+     * @brief Prefetches a set of nodes.
+     *
+     * @param process The process to read memory of.
+     * @param addresses The addresses of the nodes to prefetch.
+     */
+    void prefetch(const ProcessInfo& process, std::span<const Address> addresses) {
+        this->prefetched_addresses.assign(addresses.begin(), addresses.end());
+        std::sort(this->prefetched_addresses.begin(), this->prefetched_addresses.end());
+        this->prefetched_addresses.erase(
+            std::unique(this->prefetched_addresses.begin(), this->prefetched_addresses.end()),
+            this->prefetched_addresses.end());
+
+        this->prefetched_nodes.resize(this->prefetched_addresses.size());
+        this->prefetched_requests.resize(this->prefetched_addresses.size());
+
+        this->batch.clear();
+        for (size_t i = 0; i < this->prefetched_addresses.size(); i++) {
+            this->prefetched_requests[i] =
+                this->batch.add(this->prefetched_addresses[i], this->prefetched_nodes[i]);
+        }
+        this->batch.execute(process);
+        this->individual_reads = 0;
+    }
+    void prefetch(ProcessId process, std::span<const Address> addresses) = delete;
+
+    /**
+     * @brief Reads a node, using the prefetched copy if available.
+     *
+     * @param process The process to read memory of.
+     * @param address The address of the node.
+     * @param node The node to read into.
+     * @return True on success, false on failure.
+     */
+    bool read(const ProcessInfo& process, Address address, Node& node) {
+        auto prefetched = std::lower_bound(this->prefetched_addresses.begin(),
+                                           this->prefetched_addresses.end(), address);
+        if (prefetched != this->prefetched_addresses.end() && *prefetched == address) {
+            auto idx = prefetched - this->prefetched_addresses.begin();
+            if (this->batch.succeeded(this->prefetched_requests[idx])) {
+                node = this->prefetched_nodes[idx];
+                return true;
+            }
+        }
+
+        this->individual_reads++;
+        return read_mem(process, address, reinterpret_cast<uint8_t*>(&node), sizeof(node));
+    }
+    bool read(ProcessId process, Address address, Node& node) = delete;
+
+    /**
+     * @brief Gets the number of nodes which had to be read individually since the last prefetch.
+     *
+     * @return The number of individual reads.
+     */
+    [[nodiscard]] size_t num_individual_reads(void) const { return this->individual_reads; }
+};
+
+/**
+ * @brief Walks a remote linked list.
+ * @note Works for singly linked lists, and doubly linked lists in either direction. Circular
+ *       lists with a sentinel node can be walked by passing the sentinel as the end address.
+ * @note Retains the process endianness, apart from the link fields.
+ *
+ * @tparam Node The node type.
+ * @tparam next A pointer to the member of the node holding the next link.
+ * @tparam prev A pointer to the member of the node holding the previous link, or nullptr if the
+ *              list is singly linked.
+ */
+template <typename Node, auto next, auto prev = nullptr>
+class RemoteList {
+   private:
+    std::vector<Address> addresses;
+    std::vector<Node> nodes;
+    RemoteNodeReader<Node> reader{};
+    AddressSet visited{};
+    size_t max_nodes;
+    bool complete{false};
+
+    /**
+     * @brief Walks the list following the given link.
+     *
+     * @tparam link A pointer to the member of the node holding the link to follow.
+     * @param process The process to read memory of.
+     * @param first The address of the first node.
+     * @param end The address to stop at, in addition to null.
+     * @return A view of the read nodes.
+     */
+    template <auto link>
+    std::span<const Node> walk_links(const ProcessInfo& process, Address first, Address end) {
+        this->reader.prefetch(process, this->addresses);
+        this->visited.clear(this->addresses.size());
+        this->addresses.clear();
+        this->nodes.clear();
+        this->complete = false;
+
+        auto current = first;
+        while (true) {
+            if (current == 0 || current == end) {
+                this->complete = true;
+                break;
+            }
+            if (this->nodes.size() >= this->max_nodes || !this->visited.insert(current)) {
+                break;
+            }
+
+            Node node{};
+            if (!this->reader.read(process, current, node)) {
+                break;
+            }
+            this->addresses.push_back(current);
+            this->nodes.push_back(node);
+            current = remote_link_address(process, node.*link);
+        }
+
+        return this->nodes;
+    }
+
+   public:
+    static const constexpr size_t DEFAULT_MAX_NODES = 0x10000;
+
+    /**
+     * @brief Constructs a new list walker.
+     *
+     * @param max_nodes The maximum number of nodes to walk before giving up.
+     */
+    explicit RemoteList(size_t max_nodes = DEFAULT_MAX_NODES) : max_nodes(max_nodes) {}
+
+    /**
+     * @brief Walks the list forwards.
+     * @note Stops at a null link, the end address, a cycle, a failed read, or the node limit.
+     *
+     * @param process The process to read memory of.
+     * @param first The address of the first node.
+     * @param end The address to stop at, in addition to null. For circular lists, the sentinel.
+     * @return A view of the read nodes, valid until the next walk.
+     */
+    std::span<const Node> walk(const ProcessInfo& process, Address first, Address end = 0) {
+        return this->walk_links<next>(process, first, end);
+    }
+    std::span<const Node> walk(ProcessId process, Address first, Address end = 0) = delete;
+
+    /**
+     * @brief Walks the list backwards.
+     * @note Stops at a null link, the end address, a cycle, a failed read, or the node limit.
+     *
+     * @param process The process to read memory of.
+     * @param last The address of the last node.
+     * @param end The address to stop at, in addition to null. For circular lists, the sentinel.
+     * @return A view of the read nodes, valid until the next walk.
+     */
+    std::span<const Node> walk_backward(const ProcessInfo& process, Address last, Address end = 0)
+        requires(prev != nullptr)
+    {
+        return this->walk_links<prev>(process, last, end);
+    }
+    std::span<const Node> walk_backward(ProcessId process, Address last, Address end = 0) = delete;
+
+    /**
+     * @brief Gets the addresses of the nodes from the last walk.
+     *
+     * @return A view of the addresses, in the same order as the nodes.
+     */
+    [[nodiscard]] std::span<const Address> node_addresses(void) const { return this->addresses; }
+
+    /**
+     * @brief Checks if the last walk reached the end of the list.
+     *
+     * @return False if the last walk stopped early, due to a cycle, a failed read, or the node
+     *         limit.
+     */
+    [[nodiscard]] bool is_complete(void) const { return this->complete; }
+
+    /**
+     * @brief Gets the number of nodes which weren't prefetched during the last walk.
+     * @note Zero if the list didn't change since the walk before.
+     *
+     * @return The number of individual reads.
+     */
+    [[nodiscard]] size_t num_individual_reads(void) const {
+        return this->reader.num_individual_reads();
+    }
+};
+
+/**
+ * @brief Walks a remote binary tree, in order.
+ * @note Suitable for red-black trees such as `std::map` - pass the tree's sentinel as the nil
+ *       address if leaves point at it rather than being null.
+ * @note Retains the process endianness, apart from the link fields.
+ *
+ * @tparam Node The node type.
+ * @tparam left A pointer to the member of the node holding the left child.
+ * @tparam right A pointer to the member of the node holding the right child.
+ */
+template <typename Node, auto left, auto right>
+class RemoteTree {
+   private:
+    std::vector<Address> addresses;
+    std::vector<Node> nodes;
+    std::vector<std::pair<Address, Node>> stack;
+    RemoteNodeReader<Node> reader{};
+    AddressSet visited{};
+    size_t max_nodes;
+    bool complete{false};
+
+   public:
+    static const constexpr size_t DEFAULT_MAX_NODES = 0x10000;
+
+    /**
+     * @brief Constructs a new tree walker.
+     *
+     * @param max_nodes The maximum number of nodes to walk before giving up.
+     */
+    explicit RemoteTree(size_t max_nodes = DEFAULT_MAX_NODES) : max_nodes(max_nodes) {}
+
+    /**
+     * @brief Walks the tree, in order.
+     * @note Stops at a cycle, a failed read, or the node limit.
+     *
+     * @param process The process to read memory of.
+     * @param root The address of the root node.
+     * @param nil The address used for empty children, in addition to null.
+     * @return A view of the read nodes, valid until the next walk.
+     */
+    std::span<const Node> walk(const ProcessInfo& process, Address root, Address nil = 0) {
+        this->reader.prefetch(process, this->addresses);
+        this->visited.clear(this->addresses.size());
+        this->addresses.clear();
+        this->nodes.clear();
+        this->stack.clear();
+        this->complete = false;
+
+        auto current = root;
+        while (true) {
+            while (current != 0 && current != nil) {
+                if (this->addresses.size() + this->stack.size() >= this->max_nodes
+                    || !this->visited.insert(current)) {
+                    return this->nodes;
+                }
+
+                Node node{};
+                if (!this->reader.read(process, current, node)) {
+                    return this->nodes;
+                }
+                this->stack.emplace_back(current, node);
+                current = remote_link_address(process, node.*left);
+            }
+
+            if (this->stack.empty()) {
+                break;
+            }
+
+            auto [addr, node] = this->stack.back();
+            this->stack.pop_back();
+            this->addresses.push_back(addr);
+            this->nodes.push_back(node);
+            current = remote_link_address(process, node.*right);
+        }
+
+        this->complete = true;
+        return this->nodes;
+    }
+    std::span<const Node> walk(ProcessId process, Address root, Address nil = 0) = delete;
+
+    /**
+     * @brief Gets the addresses of the nodes from the last walk.
+     *
+     * @return A view of the addresses, in the same order as the nodes.
+     */
+    [[nodiscard]] std::span<const Address> node_addresses(void) const { return this->addresses; }
+
+    /**
+     * @brief Checks if the last walk visited the entire tree.
+     *
+     * @return False if the last walk stopped early, due to a cycle, a failed read, or the node
+     *         limit.
+     */
+    [[nodiscard]] bool is_complete(void) const { return this->complete; }
+
+    /**
+     * @brief Gets the number of nodes which weren't prefetched during the last walk.
+     * @note Zero if the tree didn't change since the walk before.
+     *
+     * @return The number of individual reads.
+     */
+    [[nodiscard]] size_t num_individual_reads(void) const {
+        return this->reader.num_individual_reads();
+    }
+};
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_REMOTE_COLLECTIONS_H */
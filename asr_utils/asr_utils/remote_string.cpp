@@ -0,0 +1,270 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/remote_string.h"
+#include "asr_utils/read_mem.h"
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+namespace asr_utils {
+inline namespace v0 {
+
+namespace {
+
+/*
+Most of the strings we read are plain ASCII, so the converter's built around a fast path which
+checks a whole block of code units at once, and if none of them have any bits above 0x7F, just
+narrows them all. Only once a block contains something else do we decode one code point at a time,
+and we jump back to the fast path straight after it.
+
+The remote characters are read into a scratch buffer first - we can't convert in place, since a
+single UTF-16 code unit can turn into three UTF-8 bytes.
+*/
+
+// NOLINTBEGIN(readability-magic-numbers)
+const constexpr char16_t UTF16_NON_ASCII_MASK = 0xFF80;
+const constexpr uint64_t UTF16_NON_ASCII_MASK_X4 = 0xFF80FF80FF80FF80;
+const constexpr size_t UTF16_UNITS_PER_WORD = sizeof(uint64_t) / sizeof(char16_t);
+const constexpr size_t UTF8_MAX_BYTES_PER_UTF16_UNIT = 3;
+
+const constexpr char32_t UTF16_HIGH_SURROGATE_START = 0xD800;
+const constexpr char32_t UTF16_LOW_SURROGATE_START = 0xDC00;
+const constexpr char32_t UTF16_SURROGATE_END = 0xE000;
+const constexpr char32_t UTF16_SURROGATE_OFFSET = 0x10000;
+const constexpr char32_t UNICODE_REPLACEMENT_CHARACTER = 0xFFFD;
+// NOLINTEND(readability-magic-numbers)
+
+thread_local std::u16string utf16_scratch{};
+
+/**
+ * @brief Converts as many leading ASCII characters as possible.
+ *
+ * @param in The UTF-16 code units to convert.
+ * @param size The number of code units available.
+ * @param out The buffer to write the converted characters to.
+ * @return The number of characters converted.
+ */
+size_t utf16_convert_ascii(const char16_t* in, size_t size, char* out) {
+    size_t idx = 0;
+
+#ifdef __wasm_simd128__
+    const auto simd_units = sizeof(v128_t) / sizeof(char16_t);
+    const auto mask = wasm_u16x8_splat(UTF16_NON_ASCII_MASK);
+    for (; idx + (2 * simd_units) <= size; idx += 2 * simd_units) {
+        auto low = wasm_v128_load(&in[idx]);
+        auto high = wasm_v128_load(&in[idx + simd_units]);
+        if (wasm_v128_any_true(wasm_v128_and(wasm_v128_or(low, high), mask))) {
+            break;
+        }
+        wasm_v128_store(&out[idx], wasm_u8x16_narrow_i16x8(low, high));
+    }
+#endif
+
+    for (; idx + UTF16_UNITS_PER_WORD <= size; idx += UTF16_UNITS_PER_WORD) {
+        uint64_t word{};
+        memcpy(&word, &in[idx], sizeof(word));
+        if ((word & UTF16_NON_ASCII_MASK_X4) != 0) {
+            break;
+        }
+        for (size_t i = 0; i < UTF16_UNITS_PER_WORD; i++) {
+            out[idx + i] = static_cast<char>(in[idx + i]);
+        }
+    }
+
+    // Finish off the block which failed, up until the first non-ascii character
+    for (; idx < size && (in[idx] & UTF16_NON_ASCII_MASK) == 0; idx++) {
+        out[idx] = static_cast<char>(in[idx]);
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Encodes a single code point as UTF-8.
+ *
+ * @param code_point The code point to encode.
+ * @param out The buffer to write to. Must have space for 4 bytes.
+ * @return The number of bytes written.
+ */
+size_t encode_utf8(char32_t code_point, char* out) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    if (code_point < 0x80) {
+        out[0] = static_cast<char>(code_point);
+        return 1;
+    }
+    if (code_point < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+        out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+        out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+    out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 4;
+    // NOLINTEND(readability-magic-numbers)
+}
+
+/**
+ * @brief Converts the UTF-16 scratch buffer to UTF-8, fixing it's endianness first if needed.
+ *
+ * @param process The process the string was read from.
+ * @param out The string to write the result into.
+ */
+void convert_scratch(const ProcessInfo& process, std::string& out) {
+    fix_endianness(process, std::span{utf16_scratch});
+    utf16_to_utf8(utf16_scratch, out);
+}
+
+/**
+ * @brief Reads a fixed number of UTF-16 code units into the scratch buffer, and converts them.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the characters.
+ * @param num_chars The number of code units to read.
+ * @param out The string to write the result into. Cleared on failure.
+ * @return True on success, false on failure.
+ */
+bool read_sized_utf16(const ProcessInfo& process,
+                      Address address,
+                      size_t num_chars,
+                      std::string& out) {
+    utf16_scratch.resize(num_chars);
+    if (num_chars > 0
+        && !read_mem(process, address, reinterpret_cast<uint8_t*>(utf16_scratch.data()),
+                     num_chars * sizeof(char16_t))) {
+        out.clear();
+        return false;
+    }
+    convert_scratch(process, out);
+    return true;
+}
+
+}  // namespace
+
+void utf16_to_utf8(std::u16string_view str, std::string& out) {
+    // Surrogate pairs only take 4 bytes for 2 units, so 3 bytes per unit is the worst case
+    out.resize(str.size() * UTF8_MAX_BYTES_PER_UTF16_UNIT);
+    auto* dest = out.data();
+
+    size_t idx = 0;
+    while (idx < str.size()) {
+        auto num_ascii = utf16_convert_ascii(&str[idx], str.size() - idx, dest);
+        idx += num_ascii;
+        dest += num_ascii;
+        if (idx >= str.size()) {
+            break;
+        }
+
+        char32_t code_point = str[idx++];
+        if (code_point >= UTF16_HIGH_SURROGATE_START && code_point < UTF16_SURROGATE_END) {
+            if (code_point < UTF16_LOW_SURROGATE_START && idx < str.size()
+                && str[idx] >= UTF16_LOW_SURROGATE_START && str[idx] < UTF16_SURROGATE_END) {
+                auto high = code_point - UTF16_HIGH_SURROGATE_START;
+                auto low = str[idx++] - UTF16_LOW_SURROGATE_START;
+                // NOLINTNEXTLINE(readability-magic-numbers)
+                code_point = UTF16_SURROGATE_OFFSET + (high << 10) + low;
+            } else {
+                code_point = UNICODE_REPLACEMENT_CHARACTER;
+            }
+        }
+        dest += encode_utf8(code_point, dest);
+    }
+
+    out.resize(dest - out.data());
+}
+
+std::string utf16_to_utf8(std::u16string_view str) {
+    std::string out{};
+    utf16_to_utf8(str, out);
+    return out;
+}
+
+bool read_utf16_string_into(const ProcessInfo& process,
+                            Address address,
+                            std::string& out,
+                            size_t max_chars) {
+    if (!read_string_into(process, address, utf16_scratch, max_chars)) {
+        out.clear();
+        return false;
+    }
+    convert_scratch(process, out);
+    return true;
+}
+
+std::string read_utf16_string(const ProcessInfo& process, Address address, size_t max_chars) {
+    std::string out{};
+    read_utf16_string_into(process, address, out, max_chars);
+    return out;
+}
+
+bool read_dotnet_string_into(const ProcessInfo& process,
+                             Address address,
+                             std::string& out,
+                             size_t max_chars) {
+    if (address == 0) {
+        out.clear();
+        return false;
+    }
+
+    auto length_addr = address + (process.is_64_bit ? sizeof(uint64_t) : sizeof(uint32_t));
+    int32_t length{};
+    if (!read_mem(process, length_addr, reinterpret_cast<uint8_t*>(&length), sizeof(length))) {
+        out.clear();
+        return false;
+    }
+    length = fix_endianness(process, length);
+    if (length < 0 || static_cast<size_t>(length) > max_chars) {
+        out.clear();
+        return false;
+    }
+
+    return read_sized_utf16(process, length_addr + sizeof(length), length, out);
+}
+
+std::string read_dotnet_string(const ProcessInfo& process, Address address, size_t max_chars) {
+    std::string out{};
+    read_dotnet_string_into(process, address, out, max_chars);
+    return out;
+}
+
+bool read_fstring_into(const ProcessInfo& process,
+                       Address address,
+                       std::string& out,
+                       size_t max_chars) {
+    auto count_addr = address + (process.is_64_bit ? sizeof(uint64_t) : sizeof(uint32_t));
+    int32_t count{};
+    if (!read_mem(process, count_addr, reinterpret_cast<uint8_t*>(&count), sizeof(count))) {
+        out.clear();
+        return false;
+    }
+    count = fix_endianness(process, count);
+
+    // Empty strings have a count of 0 and no allocation, otherwise the count includes the null
+    auto data = read_address(process, address);
+    if (count <= 0 || data == 0) {
+        out.clear();
+        return count == 0;
+    }
+    if (static_cast<size_t>(count) - 1 > max_chars) {
+        out.clear();
+        return false;
+    }
+
+    return read_sized_utf16(process, data, count - 1, out);
+}
+
+std::string read_fstring(const ProcessInfo& process, Address address, size_t max_chars) {
+    std::string out{};
+    read_fstring_into(process, address, out, max_chars);
+    return out;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
@@ -0,0 +1,134 @@
+#ifndef ASR_UTILS_REMOTE_STRING_H
+#define ASR_UTILS_REMOTE_STRING_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief Converts a UTF-16 string to UTF-8.
+ * @note Invalid surrogates are replaced with U+FFFD.
+ *
+ * @param str The string to convert.
+ * @param out The string to write the result into. Any existing contents are replaced.
+ */
+void utf16_to_utf8(std::u16string_view str, std::string& out);
+/**
+ * @brief Converts a UTF-16 string to UTF-8.
+ * @note Invalid surrogates are replaced with U+FFFD.
+ *
+ * @param str The string to convert.
+ * @return The converted string.
+ */
+std::string utf16_to_utf8(std::u16string_view str);
+
+/**
+ * @brief Reads a null terminated UTF-16 string, and converts it to UTF-8.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the string to read.
+ * @param out The string to read into. Cleared on failure.
+ * @param max_chars The maximum length of the string to read, in UTF-16 code units.
+ * @return True on success, false on failure.
+ */
+bool read_utf16_string_into(const ProcessInfo& process,
+                            Address address,
+                            std::string& out,
+                            size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+bool read_utf16_string_into(ProcessId process,
+                            Address address,
+                            std::string& out,
+                            size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+/**
+ * @brief Reads a null terminated UTF-16 string, and converts it to UTF-8.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the string to read.
+ * @param max_chars The maximum length of the string to read, in UTF-16 code units.
+ * @return The string, or an empty string if the read failed.
+ */
+std::string read_utf16_string(const ProcessInfo& process,
+                              Address address,
+                              size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+std::string read_utf16_string(ProcessId process,
+                              Address address,
+                              size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+/**
+ * @brief Reads a .NET `System.String`, and converts it to UTF-8.
+ * @note The string object is laid out as a method table pointer, a 32-bit length, then the
+ *       characters.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the string object, i.e. the value of a reference to it.
+ * @param out The string to read into. Cleared on failure.
+ * @param max_chars The maximum length of string to accept. Longer strings are treated as invalid.
+ * @return True on success, false on failure.
+ */
+bool read_dotnet_string_into(const ProcessInfo& process,
+                             Address address,
+                             std::string& out,
+                             size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+bool read_dotnet_string_into(ProcessId process,
+                             Address address,
+                             std::string& out,
+                             size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+/**
+ * @brief Reads a .NET `System.String`, and converts it to UTF-8.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the string object, i.e. the value of a reference to it.
+ * @param max_chars The maximum length of string to accept. Longer strings are treated as invalid.
+ * @return The string, or an empty string if the read failed.
+ */
+std::string read_dotnet_string(const ProcessInfo& process,
+                               Address address,
+                               size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+std::string read_dotnet_string(ProcessId process,
+                               Address address,
+                               size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+/**
+ * @brief Reads an Unreal `FString`, and converts it to UTF-8.
+ * @note The string is laid out as a pointer to the characters, a 32-bit count (including the null
+ *       terminator), then a 32-bit capacity. Assumes 16-bit `TCHAR`s, as on Windows.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the `FString` itself.
+ * @param out The string to read into. Cleared on failure.
+ * @param max_chars The maximum length of string to accept. Longer strings are treated as invalid.
+ * @return True on success, false on failure.
+ */
+bool read_fstring_into(const ProcessInfo& process,
+                       Address address,
+                       std::string& out,
+                       size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+bool read_fstring_into(ProcessId process,
+                       Address address,
+                       std::string& out,
+                       size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+/**
+ * @brief Reads an Unreal `FString`, and converts it to UTF-8.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the `FString` itself.
+ * @param max_chars The maximum length of string to accept. Longer strings are treated as invalid.
+ * @return The string, or an empty string if the read failed.
+ */
+std::string read_fstring(const ProcessInfo& process,
+                         Address address,
+                         size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS);
+std::string read_fstring(ProcessId process,
+                         Address address,
+                         size_t max_chars = READ_STRING_DEFAULT_MAX_CHARS) = delete;
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_REMOTE_STRING_H */
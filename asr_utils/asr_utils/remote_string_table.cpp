@@ -0,0 +1,141 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/remote_string_table.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/*
+Entries live in a flat vector, threaded into a doubly linked recently used list by index, so
+moving one to the front never allocates. Once the table's full, new strings reuse the slot of the
+least recently used entry.
+
+String bytes are only ever appended to the storage buffer - evicting an entry just counts it's bytes
+as dead. Once over half the buffer is dead, it gets rebuilt from the live entries, which keeps it
+bounded at twice the size of the live strings.
+*/
+
+RemoteStringTable::RemoteStringTable(Resolver resolver, size_t capacity)
+    : resolver(std::move(resolver)),
+      capacity(std::clamp<size_t>(capacity, 1, NO_ENTRY)) {
+    this->entries.reserve(this->capacity);
+    this->lookup.reserve(this->capacity);
+}
+
+void RemoteStringTable::unlink(uint32_t idx) {
+    auto& entry = this->entries[idx];
+    if (entry.prev == NO_ENTRY) {
+        this->most_recent = entry.next;
+    } else {
+        this->entries[entry.prev].next = entry.next;
+    }
+    if (entry.next == NO_ENTRY) {
+        this->least_recent = entry.prev;
+    } else {
+        this->entries[entry.next].prev = entry.prev;
+    }
+    entry.prev = NO_ENTRY;
+    entry.next = NO_ENTRY;
+}
+
+void RemoteStringTable::push_front(uint32_t idx) {
+    auto& entry = this->entries[idx];
+    entry.prev = NO_ENTRY;
+    entry.next = this->most_recent;
+    if (this->most_recent == NO_ENTRY) {
+        this->least_recent = idx;
+    } else {
+        this->entries[this->most_recent].prev = idx;
+    }
+    this->most_recent = idx;
+}
+
+void RemoteStringTable::compact(void) {
+    this->compact_storage.clear();
+    this->compact_storage.reserve(this->storage.size() - this->dead_bytes);
+
+    for (auto idx = this->most_recent; idx != NO_ENTRY; idx = this->entries[idx].next) {
+        auto& entry = this->entries[idx];
+        auto new_offset = this->compact_storage.size();
+        this->compact_storage.append(this->storage, entry.offset, entry.size);
+        entry.offset = new_offset;
+    }
+
+    std::swap(this->storage, this->compact_storage);
+    this->dead_bytes = 0;
+}
+
+std::string_view RemoteStringTable::get(const ProcessInfo& process, uint64_t id) {
+    if (process.pid != this->pid || process.main_module != this->main_module) {
+        this->clear();
+        this->pid = process.pid;
+        this->main_module = process.main_module;
+    }
+
+    auto existing = this->lookup.find(id);
+    if (existing != this->lookup.end()) {
+        this->hit_count++;
+        auto idx = existing->second;
+        this->unlink(idx);
+        this->push_front(idx);
+        return std::string_view{this->storage}.substr(this->entries[idx].offset,
+                                                      this->entries[idx].size);
+    }
+
+    this->miss_count++;
+    this->scratch.clear();
+    if (!this->resolver(process, id, this->scratch)) {
+        return {};
+    }
+
+    uint32_t idx{};
+    if (this->entries.size() < this->capacity) {
+        idx = static_cast<uint32_t>(this->entries.size());
+        this->entries.push_back({});
+    } else {
+        idx = this->least_recent;
+        this->unlink(idx);
+        this->lookup.erase(this->entries[idx].id);
+        this->dead_bytes += this->entries[idx].size;
+
+        if (this->dead_bytes > this->storage.size() / 2) {
+            this->compact();
+        }
+    }
+
+    this->entries[idx] = {id, this->storage.size(), this->scratch.size(), NO_ENTRY, NO_ENTRY};
+    this->storage.append(this->scratch);
+    this->push_front(idx);
+    this->lookup.emplace(id, idx);
+
+    return std::string_view{this->storage}.substr(this->entries[idx].offset,
+                                                  this->entries[idx].size);
+}
+
+void RemoteStringTable::clear(void) {
+    this->entries.clear();
+    this->lookup.clear();
+    this->most_recent = NO_ENTRY;
+    this->least_recent = NO_ENTRY;
+    this->storage.clear();
+    this->dead_bytes = 0;
+}
+
+size_t RemoteStringTable::size(void) const {
+    return this->entries.size();
+}
+
+uint64_t RemoteStringTable::hits(void) const {
+    return this->hit_count;
+}
+
+uint64_t RemoteStringTable::misses(void) const {
+    return this->miss_count;
+}
+
+void RemoteStringTable::reset_stats(void) {
+    this->hit_count = 0;
+    this->miss_count = 0;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
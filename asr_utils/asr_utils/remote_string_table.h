@@ -0,0 +1,134 @@
+#ifndef ASR_UTILS_REMOTE_STRING_TABLE_H
+#define ASR_UTILS_REMOTE_STRING_TABLE_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief Cache of strings looked up by integer id, e.g. names out of an FName pool.
+ * @note Keeps the most recently used strings in a bounded LRU, with all the string bytes stored in
+ *       a single buffer.
+ * @note Automatically cleared if used with a different process.
+ */
+class RemoteStringTable {
+   public:
+    /**
+     * @brief Callback which resolves an id to a string, usually via `read_address`/`read_string`.
+     *
+     * @param process The process to read memory of.
+     * @param id The id to resolve.
+     * @param out The string to write the result into. Always empty when called.
+     * @return True on success, false on failure.
+     */
+    using Resolver = std::function<bool(const ProcessInfo& process, uint64_t id, std::string& out)>;
+
+    static const constexpr size_t DEFAULT_CAPACITY = 1024;
+
+   private:
+    struct Entry {
+        uint64_t id;
+        size_t offset;
+        size_t size;
+        uint32_t prev;
+        uint32_t next;
+    };
+    static const constexpr uint32_t NO_ENTRY = std::numeric_limits<uint32_t>::max();
+
+    Resolver resolver;
+    size_t capacity;
+
+    std::vector<Entry> entries;
+    std::unordered_map<uint64_t, uint32_t> lookup;
+    uint32_t most_recent{NO_ENTRY};
+    uint32_t least_recent{NO_ENTRY};
+
+    std::string storage;
+    std::string compact_storage;
+    size_t dead_bytes{0};
+    std::string scratch;
+
+    ProcessId pid{0};
+    Address main_module{0};
+
+    uint64_t hit_count{0};
+    uint64_t miss_count{0};
+
+    /**
+     * @brief Removes an entry from the recently used list.
+     *
+     * @param idx The index of the entry.
+     */
+    void unlink(uint32_t idx);
+
+    /**
+     * @brief Adds an entry to the front of the recently used list.
+     *
+     * @param idx The index of the entry.
+     */
+    void push_front(uint32_t idx);
+
+    /**
+     * @brief Rebuilds the string storage, removing the bytes of evicted entries.
+     */
+    void compact(void);
+
+   public:
+    /**
+     * @brief Constructs a new string table.
+     *
+     * @param resolver The callback used to resolve ids which aren't cached.
+     * @param capacity The maximum amount of strings to cache.
+     */
+    explicit RemoteStringTable(Resolver resolver, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Gets the string for an id, resolving it if it isn't cached.
+     * @note Failed lookups are not cached, they get retried next call.
+     *
+     * @param process The process to read memory of.
+     * @param id The id to look up.
+     * @return A view of the string, or an empty view if it couldn't be resolved. Only valid until
+     *         the next call to `get` or `clear`.
+     */
+    std::string_view get(const ProcessInfo& process, uint64_t id);
+    std::string_view get(ProcessId process, uint64_t id) = delete;
+
+    /**
+     * @brief Removes all cached strings.
+     */
+    void clear(void);
+
+    /**
+     * @brief Gets the amount of strings currently cached.
+     *
+     * @return The amount of cached strings.
+     */
+    [[nodiscard]] size_t size(void) const;
+
+    /**
+     * @brief Gets the amount of lookups served from the cache since the last stats reset.
+     *
+     * @return The hit count.
+     */
+    [[nodiscard]] uint64_t hits(void) const;
+
+    /**
+     * @brief Gets the amount of lookups which had to be resolved since the last stats reset.
+     *
+     * @return The miss count.
+     */
+    [[nodiscard]] uint64_t misses(void) const;
+
+    /**
+     * @brief Resets the hit and miss counts.
+     */
+    void reset_stats(void);
+};
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_REMOTE_STRING_TABLE_H */
@@ -0,0 +1,138 @@
+#ifndef ASR_UTILS_REMOTE_STRUCT_H
+#define ASR_UTILS_REMOTE_STRUCT_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief Helper to split a pointer to member into it's class and value types.
+ *
+ * @tparam T The pointer to member type.
+ */
+template <typename T>
+struct MemberPointerTraits;
+template <typename Class, typename T>
+struct MemberPointerTraits<T Class::*> {
+    using class_type = Class;
+    using value_type = T;
+};
+
+/**
+ * @brief Describes a single field of a remote struct.
+ * @note Fields must be scalars, so that their endianness can be fixed. Describe arrays or nested
+ *       structs as one field per element.
+ *
+ * @tparam member A pointer to the local member to store the field in.
+ * @tparam offset The offset of the field in the remote struct.
+ * @tparam RemoteT The type of the field in the remote struct. Defaults to the member's type, but
+ *                 may be different, e.g. to read a 32-bit pointer into an `Address`.
+ */
+template <auto member,
+          size_t offset,
+          typename RemoteT = typename MemberPointerTraits<decltype(member)>::value_type>
+struct RemoteField {
+    using Struct = typename MemberPointerTraits<decltype(member)>::class_type;
+    using Value = typename MemberPointerTraits<decltype(member)>::value_type;
+    using Remote = RemoteT;
+
+    static const constexpr size_t START = offset;
+    static const constexpr size_t END = offset + sizeof(RemoteT);
+
+    static_assert(std::is_scalar_v<RemoteT>, "remote field types must be scalars");
+
+    /**
+     * @brief Decodes this field out of a buffer holding the remote struct.
+     *
+     * @param buffer A pointer to this field's bytes, within a buffer holding the remote struct.
+     * @param swap True if the value's endianness needs to be swapped.
+     * @param out The struct to store the field in.
+     */
+    static void decode(const uint8_t* buffer, bool swap, Struct& out) {
+        RemoteT val{};
+        memcpy(&val, buffer, sizeof(val));
+        if (swap) {
+            val = swap_endianness(val);
+        }
+        out.*member = static_cast<Value>(val);
+    }
+};
+
+/**
+ * @brief Describes the layout of a remote struct, so that it can be read in one go.
+ * @note Reads the whole span of the fields in a single read, then decodes each field out of it.
+ *
+ * @tparam Struct The local struct type to read into.
+ * @tparam Fields The `RemoteField`s making up the struct.
+ */
+template <typename Struct, typename... Fields>
+struct RemoteStruct {
+    static_assert(sizeof...(Fields) > 0, "remote structs must have at least one field");
+    static_assert((std::is_same_v<Struct, typename Fields::Struct> && ...),
+                  "all fields must belong to the struct being read");
+
+    static const constexpr size_t START = std::min({Fields::START...});
+    static const constexpr size_t END = std::max({Fields::END...});
+    static const constexpr size_t SIZE = END - START;
+
+    /**
+     * @brief Reads the struct from a process.
+     * @note Fields not included in the layout are left untouched.
+     *
+     * @param process The process to read memory of.
+     * @param address The address of the remote struct.
+     * @param out The struct to read into. Left untouched on failure.
+     * @return True on success, false on failure.
+     */
+    static bool read(const ProcessInfo& process, Address address, Struct& out) {
+        std::array<uint8_t, SIZE> buffer{};
+        if (!read_mem(process, address + START, buffer.data(), buffer.size())) {
+            return false;
+        }
+
+        auto swap = process.endianness != std::endian::native;
+        (Fields::decode(&buffer[Fields::START - START], swap, out), ...);
+        return true;
+    }
+    static bool read(ProcessId process, Address address, Struct& out) = delete;
+
+    /**
+     * @brief Reads the struct from a process.
+     *
+     * @param process The process to read memory of.
+     * @param address The address of the remote struct.
+     * @return The read struct, or it's default constructed version if the read fails.
+     */
+    static Struct read(const ProcessInfo& process, Address address) {
+        Struct out{};
+        read(process, address, out);
+        return out;
+    }
+    static Struct read(ProcessId process, Address address) = delete;
+};
+
+/**
+ * @brief Reads a struct whose layout depends on the process's pointer size.
+ *
+ * @tparam Layout An alias template taking `is_64_bit`, giving the `RemoteStruct` to use.
+ * @tparam Struct The local struct type to read into.
+ * @param process The process to read memory of.
+ * @param address The address of the remote struct.
+ * @param out The struct to read into. Left untouched on failure.
+ * @return True on success, false on failure.
+ */
+template <template <bool> typename Layout, typename Struct>
+bool read_struct(const ProcessInfo& process, Address address, Struct& out) {
+    return process.is_64_bit ? Layout<true>::read(process, address, out)
+                             : Layout<false>::read(process, address, out);
+}
+template <template <bool> typename Layout, typename Struct>
+bool read_struct(ProcessId process, Address address, Struct& out) = delete;
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_REMOTE_STRUCT_H */
@@ -2,13 +2,20 @@
 #include "asr_utils/sigscan.h"
 #include "asr_utils/asr_extensions.h"
 
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+#ifdef ASR_UTILS_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
 namespace asr_utils {
 inline namespace v0 {
 
 namespace {
 
-const constexpr auto SIGSCAN_CHUNK_SIZE = 0x1000;
-
 /*
 Because we're in another process, we need to read in chunks of memory while sigscanning, we can't
 just load the entire range.
@@ -30,24 +37,32 @@ check if the suffix also matches.
 
 We index these by number of bytes in the prefix. This wastes the 0 index, but keeping it around
 makes the code cleaner.
+
+Chunks may be shorter than the pattern (e.g. a lone readable page between two unreadable ones, or
+the very end of the range), so a partial match might not finish in the next chunk either. In that
+case, it just turns into a longer partial match, and we try again on the chunk after.
 */
 
 /**
  * @brief Updates the list of partial matches at the end of a chunk.
+ * @note Expects all partial matches from previous chunks to have already been finished, and thus
+ *       for all prefixes the size of this chunk or smaller to be free.
  *
  * @param pattern The pattern to search for.
  * @param chunk The chunk of memory to match.
+ * @param chunk_size The size of the chunk.
  * @param partial_matches The list of partial matches to update.
  */
 void sigscan_find_partial_matches(const uint8_t* bytes,
                                   const uint8_t* mask,
                                   size_t pattern_size,
                                   const uint8_t* chunk,
+                                  size_t chunk_size,
                                   std::vector<bool>& partial_matches) {
-    // +1 to skip the case where all prefix bytes are within this chunk
-    for (size_t chunk_offset = (SIGSCAN_CHUNK_SIZE - pattern_size) + 1;
-         chunk_offset < SIGSCAN_CHUNK_SIZE; chunk_offset++) {
-        auto bytes_in_prefix = SIGSCAN_CHUNK_SIZE - chunk_offset;
+    // Stop before pattern size to skip the case where all prefix bytes are within this chunk
+    auto max_prefix = std::min(pattern_size - 1, chunk_size);
+    for (size_t bytes_in_prefix = 1; bytes_in_prefix <= max_prefix; bytes_in_prefix++) {
+        auto chunk_offset = chunk_size - bytes_in_prefix;
 
         bool match = true;
         for (size_t pattern_idx = 0; pattern_idx < bytes_in_prefix; pattern_idx++) {
@@ -63,28 +78,39 @@ void sigscan_find_partial_matches(const uint8_t* bytes,
 
 /**
  * @brief Checks if any partial matches from the last chunk finish in this one.
+ * @note Partial matches which continue past the end of this chunk are extended, all others are
+ *       cleared.
  *
  * @param pattern The pattern to search for.
  * @param chunk The chunk of memory to match.
+ * @param chunk_size The size of the chunk.
  * @param partial_matches The list of partial matches from the last chunk.
- * @return The number of bytes before the start of the chunk where the pattern matches, or 0 if
- *         there's no match.
+ * @param finished_matches Output list, which the number of bytes before the start of the chunk of
+ *                         each finished match is appended to. Sorted earliest first.
  */
-size_t sigscan_finish_partial_matches(const uint8_t* bytes,
-                                      const uint8_t* mask,
-                                      size_t pattern_size,
-                                      const uint8_t* chunk,
-                                      const std::vector<bool>& partial_matches) {
-    // Start at 1 to skip the case where all suffix bytes are in this chunk
-    // Go until pattern size - 1 to skip the case where all prefix bytes are in the last chunk
-    for (size_t bytes_in_prefix = 1; bytes_in_prefix < (pattern_size - 1); bytes_in_prefix++) {
+void sigscan_finish_partial_matches(const uint8_t* bytes,
+                                    const uint8_t* mask,
+                                    size_t pattern_size,
+                                    const uint8_t* chunk,
+                                    size_t chunk_size,
+                                    std::vector<bool>& partial_matches,
+                                    std::vector<size_t>& finished_matches) {
+    // Start at the longest prefix, since it gives the earliest match
+    // Start below pattern size to skip the case where all prefix bytes are in the last chunk
+    // Stop at 1 to skip the case where all suffix bytes are in this chunk
+    // Since extended matches always get a longer prefix, going backwards also means we only ever
+    // write to indexes we've already handled
+    for (size_t bytes_in_prefix = pattern_size - 1; bytes_in_prefix > 0; bytes_in_prefix--) {
         if (!partial_matches[bytes_in_prefix]) {
             continue;
         }
+        partial_matches[bytes_in_prefix] = false;
+
+        auto bytes_in_suffix = pattern_size - bytes_in_prefix;
+        auto bytes_to_check = std::min(bytes_in_suffix, chunk_size);
 
         bool match = true;
-        for (size_t chunk_offset = 0; chunk_offset < (pattern_size - bytes_in_prefix);
-             chunk_offset++) {
+        for (size_t chunk_offset = 0; chunk_offset < bytes_to_check; chunk_offset++) {
             auto pattern_idx = bytes_in_prefix + chunk_offset;
 
             if ((chunk[chunk_offset] & mask[pattern_idx]) != bytes[pattern_idx]) {
@@ -92,66 +118,948 @@ size_t sigscan_finish_partial_matches(const uint8_t* bytes,
                 break;
             }
         }
-        if (match) {
-            return bytes_in_prefix;
+        if (!match) {
+            continue;
+        }
+
+        if (bytes_to_check < bytes_in_suffix) {
+            partial_matches[bytes_in_prefix + chunk_size] = true;
+        } else {
+            finished_matches.push_back(bytes_in_prefix);
         }
     }
+}
 
-    return 0;
+/*
+Each host call has a decent amount of overhead, so we want to read as much memory at once as we
+can. This has to be balanced against two things:
+- Some scans are over small ranges, or find their match near the start, so reading a huge chunk
+  would just waste time copying memory we'll never look at.
+- A single read fails if *any* page in it is unreadable - modules can contain guard or decommitted
+  pages (particularly under proton). We don't want to give up on the entire scan because of them.
+
+So we start with a moderately sized read, and double it after every success. If a read fails, we
+split it in half (on a page boundary) and retry each half, repeating until we get down to single
+unreadable pages, which we just skip. A match can't cross an unreadable page, so whenever there's a
+gap between chunks we drop all partial matches.
+*/
+
+const constexpr size_t SIGSCAN_PAGE_SIZE = 0x1000;
+const constexpr size_t SIGSCAN_MIN_READ_SIZE = 0x10000;
+const constexpr size_t SIGSCAN_MAX_READ_SIZE = 0x100000;
+
+/**
+ * @brief A contiguous chunk of readable memory, within a sigscan read buffer.
+ */
+struct SigscanChunk {
+    Address address;
+    size_t buffer_offset;
+    size_t size;
+};
+
+/**
+ * @brief Reads memory, splitting into smaller reads on failure.
+ *
+ * @param process The process to read memory of.
+ * @param address The address to start reading at.
+ * @param buffer The buffer to read into.
+ * @param size The amount of bytes to read.
+ * @param buffer_offset The offset of this read within the overall read buffer.
+ * @param chunks The list of readable chunks to append to.
+ */
+void sigscan_read_split(ProcessId process,
+                        Address address,
+                        uint8_t* buffer,
+                        size_t size,
+                        size_t buffer_offset,
+                        std::vector<SigscanChunk>& chunks) {
+    if (::process_read(process, address, buffer, size)) {
+        if (!chunks.empty()) {
+            auto& last = chunks.back();
+            if (last.address + last.size == address) {
+                last.size += size;
+                return;
+            }
+        }
+        chunks.push_back({address, buffer_offset, size});
+        return;
+    }
+
+    // Split on the page boundary closest to the middle, failing if there's no boundary to split on
+    auto first_page = (address + SIGSCAN_PAGE_SIZE) & ~(SIGSCAN_PAGE_SIZE - 1);
+    auto middle = (address + (size / 2)) & ~(SIGSCAN_PAGE_SIZE - 1);
+    auto split = std::max(first_page, middle);
+    if (split >= address + size) {
+        return;
+    }
+
+    auto first_size = split - address;
+    sigscan_read_split(process, address, buffer, first_size, buffer_offset, chunks);
+    sigscan_read_split(process, split, buffer + first_size, size - first_size,
+                       buffer_offset + first_size, chunks);
+}
+
+/**
+ * @brief Helper class which walks over a range of memory, reading it in as large chunks as it can.
+ */
+class SigscanReader {
+   private:
+    ProcessId process;
+    Address next_address;
+    Address end;
+    size_t read_size = SIGSCAN_MIN_READ_SIZE;
+    std::vector<uint8_t> buffer;
+    std::vector<SigscanChunk> chunk_list;
+
+   public:
+    /**
+     * @brief Constructs a new reader.
+     *
+     * @param process The process to read memory of.
+     * @param start The address to start reading at.
+     * @param size The length of the region to read.
+     */
+    SigscanReader(ProcessId process, Address start, size_t size)
+        : process(process),
+          next_address(start),
+          end(start + size),
+          buffer(std::min(size, SIGSCAN_MAX_READ_SIZE)) {}
+
+    /**
+     * @brief Performs the next read.
+     *
+     * @param max_size The maximum amount of bytes to read.
+     * @return True if anything was attempted to be read, false if we've reached the end.
+     */
+    bool read(size_t max_size = std::numeric_limits<size_t>::max()) {
+        this->chunk_list.clear();
+        if (this->next_address >= this->end) {
+            return false;
+        }
+
+        auto size = std::min<size_t>({this->read_size, max_size, this->end - this->next_address});
+        sigscan_read_split(this->process, this->next_address, this->buffer.data(), size, 0,
+                           this->chunk_list);
+
+        if (this->chunk_list.size() == 1 && this->chunk_list[0].size == size) {
+            this->read_size = std::min(this->read_size * 2, SIGSCAN_MAX_READ_SIZE);
+        } else {
+            this->read_size = SIGSCAN_MIN_READ_SIZE;
+        }
+
+        this->next_address += size;
+        return true;
+    }
+
+    /**
+     * @brief Gets how many bytes are left to read.
+     *
+     * @return The remaining bytes.
+     */
+    [[nodiscard]] size_t remaining(void) const {
+        return this->next_address >= this->end ? 0 : this->end - this->next_address;
+    }
+
+    /**
+     * @brief Gets the readable chunks from the last read.
+     *
+     * @return The list of chunks.
+     */
+    [[nodiscard]] const std::vector<SigscanChunk>& chunks(void) const { return this->chunk_list; }
+
+    /**
+     * @brief Gets a pointer to the data of one of the chunks from the last read.
+     *
+     * @param chunk The chunk to get the data of.
+     * @return A pointer to the start of the chunk's data.
+     */
+    [[nodiscard]] const uint8_t* data(const SigscanChunk& chunk) const {
+        return &this->buffer[chunk.buffer_offset];
+    }
+};
+
+/**
+ * @brief Checks if the pattern matches at the given location.
+ *
+ * @param pattern The pattern to search for.
+ * @param data The memory to match, which must contain at least the full pattern size.
+ * @return True if the pattern matches.
+ */
+bool sigscan_matches_at(const uint8_t* bytes,
+                        const uint8_t* mask,
+                        size_t pattern_size,
+                        const uint8_t* data) {
+    for (size_t pattern_idx = 0; pattern_idx < pattern_size; pattern_idx++) {
+        if ((data[pattern_idx] & mask[pattern_idx]) != bytes[pattern_idx]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+The vectorized search doesn't look at the whole pattern at once, it picks a single "anchor" byte,
+and compares it against 16 offsets at a time. Only offsets where the anchor matches get the full
+(scalar) pattern check.
+
+This obviously relies on the anchor being reasonably rare - anchoring on a common byte just means
+we fall back to checking most offsets anyway. We don't know what the memory we'll be scanning looks
+like, but since most patterns are for x86 code, avoid the most common bytes in that.
+*/
+
+const constexpr uint8_t SIGSCAN_COMMON_BYTES[] = {
+    0x00,  // Padding, immediates, displacements
+    0xFF,  // Negative immediates, call/jmp indirect
+    0xCC,  // int3 padding
+    0x90,  // nop padding
+    0x48,  // REX.W
+    0x89,  // mov r/m, r
+    0x8B,  // mov r, r/m
+};
+
+/**
+ * @brief Picks the byte of a pattern to anchor vectorized searches on.
+ *
+ * @param pattern The pattern to search for.
+ * @return The index of the anchor byte, or the pattern size if there are no non-wildcard bytes.
+ */
+size_t sigscan_pick_anchor(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
+    auto first_solid = pattern_size;
+    for (size_t pattern_idx = 0; pattern_idx < pattern_size; pattern_idx++) {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        if (mask[pattern_idx] != 0xFF) {
+            continue;
+        }
+        if (std::find(std::begin(SIGSCAN_COMMON_BYTES), std::end(SIGSCAN_COMMON_BYTES),
+                      bytes[pattern_idx])
+            == std::end(SIGSCAN_COMMON_BYTES)) {
+            return pattern_idx;
+        }
+        if (first_solid == pattern_size) {
+            first_solid = pattern_idx;
+        }
+    }
+    return first_solid;
+}
+
+const constexpr auto SIGSCAN_NO_MATCH = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief Searches for the pattern within a chunk, one offset at a time.
+ *
+ * @param pattern The pattern to search for.
+ * @param chunk The chunk of memory to match.
+ * @param num_offsets The number of offsets to try. The chunk must hold a full pattern at each.
+ * @return The offset of the first match, or `SIGSCAN_NO_MATCH` if there's no match.
+ */
+size_t sigscan_find_in_chunk_scalar(const uint8_t* bytes,
+                                    const uint8_t* mask,
+                                    size_t pattern_size,
+                                    const uint8_t* chunk,
+                                    size_t num_offsets) {
+    for (size_t chunk_offset = 0; chunk_offset < num_offsets; chunk_offset++) {
+        if (sigscan_matches_at(bytes, mask, pattern_size, &chunk[chunk_offset])) {
+            return chunk_offset;
+        }
+    }
+    return SIGSCAN_NO_MATCH;
+}
+
+#ifdef __wasm_simd128__
+
+const constexpr auto SIGSCAN_SIMD_WIDTH = sizeof(v128_t);
+
+/**
+ * @brief Searches for the pattern within a chunk, using an anchor byte to test 16 offsets at once.
+ *
+ * @param pattern The pattern to search for.
+ * @param anchor The index of the anchor byte, which must be a non-wildcard byte.
+ * @param chunk The chunk of memory to match.
+ * @param num_offsets The number of offsets to try. The chunk must hold a full pattern at each.
+ * @return The offset of the first match, or `SIGSCAN_NO_MATCH` if there's no match.
+ */
+size_t sigscan_find_in_chunk_simd(const uint8_t* bytes,
+                                  const uint8_t* mask,
+                                  size_t pattern_size,
+                                  size_t anchor,
+                                  const uint8_t* chunk,
+                                  size_t num_offsets) {
+    auto anchor_vec = wasm_u8x16_splat(bytes[anchor]);
+
+    size_t chunk_offset = 0;
+    for (; chunk_offset + SIGSCAN_SIMD_WIDTH <= num_offsets; chunk_offset += SIGSCAN_SIMD_WIDTH) {
+        auto data = wasm_v128_load(&chunk[chunk_offset + anchor]);
+        uint32_t candidates = wasm_i8x16_bitmask(wasm_i8x16_eq(data, anchor_vec));
+
+        while (candidates != 0) {
+            auto candidate_offset = chunk_offset + std::countr_zero(candidates);
+            if (sigscan_matches_at(bytes, mask, pattern_size, &chunk[candidate_offset])) {
+                return candidate_offset;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+
+    auto tail_offset = sigscan_find_in_chunk_scalar(
+        bytes, mask, pattern_size, &chunk[chunk_offset], num_offsets - chunk_offset);
+    return tail_offset == SIGSCAN_NO_MATCH ? tail_offset : chunk_offset + tail_offset;
+}
+
+#else
+
+/**
+ * @brief Searches for a pattern with no wildcards within a chunk, using memchr/memcmp.
+ *
+ * @param pattern The pattern to search for.
+ * @param anchor The index of the anchor byte.
+ * @param chunk The chunk of memory to match.
+ * @param num_offsets The number of offsets to try. The chunk must hold a full pattern at each.
+ * @return The offset of the first match, or `SIGSCAN_NO_MATCH` if there's no match.
+ */
+size_t sigscan_find_in_chunk_solid(const uint8_t* bytes,
+                                   size_t pattern_size,
+                                   size_t anchor,
+                                   const uint8_t* chunk,
+                                   size_t num_offsets) {
+    size_t chunk_offset = 0;
+    while (chunk_offset < num_offsets) {
+        const auto* found = static_cast<const uint8_t*>(
+            memchr(&chunk[chunk_offset + anchor], bytes[anchor], num_offsets - chunk_offset));
+        if (found == nullptr) {
+            return SIGSCAN_NO_MATCH;
+        }
+
+        auto candidate_offset = static_cast<size_t>(found - &chunk[anchor]);
+        if (memcmp(&chunk[candidate_offset], bytes, pattern_size) == 0) {
+            return candidate_offset;
+        }
+        chunk_offset = candidate_offset + 1;
+    }
+    return SIGSCAN_NO_MATCH;
+}
+
+#endif
+
+/**
+ * @brief Builds the Horspool skip table for a pattern, if it's going to be used.
+ *
+ * @param pattern The pattern to build the table for.
+ * @return The skip table, indexed by the byte under the last pattern byte, or an empty vector if
+ *         the pattern doesn't use a Horspool search.
+ */
+std::vector<uint8_t> sigscan_build_skip_table(const PatternView& pattern) {
+#ifdef __wasm_simd128__
+    // The simd kernel takes over, see `sigscan_find_in_chunk`
+    (void)pattern;
+    return {};
+#else
+    if (pattern.matcher != PatternMatcher::HORSPOOL) {
+        return {};
+    }
+
+    // The skip for each byte is the distance from the last pattern byte it could match to the end
+    // of the pattern - ignoring the very last byte. Wildcards match everything, so they limit all
+    // skips, which is why we need a long solid suffix.
+    // Since the table is only bytes, clamp any longer skips - smaller is always still correct.
+    const size_t max_skip = std::numeric_limits<uint8_t>::max();
+    std::vector<uint8_t> skip_table(max_skip + 1,
+                                    static_cast<uint8_t>(std::min(pattern.size, max_skip)));
+    for (size_t pattern_idx = 0; pattern_idx < pattern.size - 1; pattern_idx++) {
+        auto skip = static_cast<uint8_t>(std::min(pattern.size - pattern_idx - 1, max_skip));
+        for (size_t byte = 0; byte < skip_table.size(); byte++) {
+            if ((byte & pattern.mask[pattern_idx]) == pattern.bytes[pattern_idx]) {
+                skip_table[byte] = skip;
+            }
+        }
+    }
+    return skip_table;
+#endif
+}
+
+#ifndef __wasm_simd128__
+
+/**
+ * @brief Searches for the pattern within a chunk, using a Horspool skip table.
+ *
+ * @param pattern The pattern to search for.
+ * @param skip_table The skip table to use.
+ * @param chunk The chunk of memory to match.
+ * @param num_offsets The number of offsets to try. The chunk must hold a full pattern at each.
+ * @return The offset of the first match, or `SIGSCAN_NO_MATCH` if there's no match.
+ */
+size_t sigscan_find_in_chunk_horspool(const uint8_t* bytes,
+                                      const uint8_t* mask,
+                                      size_t pattern_size,
+                                      const uint8_t* skip_table,
+                                      const uint8_t* chunk,
+                                      size_t num_offsets) {
+    auto last_idx = pattern_size - 1;
+
+    size_t chunk_offset = 0;
+    while (chunk_offset < num_offsets) {
+        auto last_byte = chunk[chunk_offset + last_idx];
+        if ((last_byte & mask[last_idx]) == bytes[last_idx]
+            && sigscan_matches_at(bytes, mask, last_idx, &chunk[chunk_offset])) {
+            return chunk_offset;
+        }
+        chunk_offset += skip_table[last_byte];
+    }
+    return SIGSCAN_NO_MATCH;
+}
+
+#endif
+
+/*
+In simd builds, any pattern with a solid byte goes through the anchor kernel, whatever matcher it
+picked. Each compare rules out 16 offsets, while Horspool can only skip up to the length of the
+solid suffix, which is usually shorter than that. The specialised matchers are just for scalar
+builds.
+*/
+
+/**
+ * @brief Searches for the pattern within a chunk, picking the fastest available method.
+ *
+ * @param pattern The pattern to search for.
+ * @param anchor The index of the anchor byte, or the pattern size if there is none.
+ * @param skip_table The pattern's skip table, from `sigscan_build_skip_table`.
+ * @param chunk The chunk of memory to match.
+ * @param num_offsets The number of offsets to try. The chunk must hold a full pattern at each.
+ * @return The offset of the first match, or `SIGSCAN_NO_MATCH` if there's no match.
+ */
+size_t sigscan_find_in_chunk(const PatternView& pattern,
+                             size_t anchor,
+                             std::span<const uint8_t> skip_table,
+                             const uint8_t* chunk,
+                             size_t num_offsets) {
+#ifdef __wasm_simd128__
+    (void)skip_table;
+    if (anchor < pattern.size) {
+        return sigscan_find_in_chunk_simd(pattern.bytes, pattern.mask, pattern.size, anchor, chunk,
+                                          num_offsets);
+    }
+#else
+    switch (pattern.matcher) {
+        case PatternMatcher::SOLID:
+            return sigscan_find_in_chunk_solid(pattern.bytes, pattern.size, anchor, chunk,
+                                               num_offsets);
+        case PatternMatcher::HORSPOOL:
+            if (!skip_table.empty()) {
+                return sigscan_find_in_chunk_horspool(pattern.bytes, pattern.mask, pattern.size,
+                                                      skip_table.data(), chunk, num_offsets);
+            }
+            break;
+        case PatternMatcher::MASKED:
+        default:
+            break;
+    }
+#endif
+    return sigscan_find_in_chunk_scalar(pattern.bytes, pattern.mask, pattern.size, chunk,
+                                        num_offsets);
 }
 
 }  // namespace
 
+struct SigscanRange::State {
+    PatternView pattern;
+    size_t anchor;
+    std::vector<uint8_t> skip_table;
+    SigscanReader reader;
+    size_t remaining_matches;
+
+    std::vector<bool> partial_matches;
+    std::vector<size_t> finished_matches{};
+    Address last_chunk_end{0};
+
+    // Where to resume the scan from
+    size_t chunk_idx{0};
+    bool chunk_started{false};
+    size_t finished_idx{0};
+    size_t chunk_offset{0};
+
+    State(ProcessId process,
+          const PatternView& pattern,
+          Address start,
+          size_t size,
+          size_t max_matches)
+        : pattern(pattern),
+          anchor(sigscan_pick_anchor(pattern.bytes, pattern.mask, pattern.size)),
+          skip_table(sigscan_build_skip_table(pattern)),
+          reader(process, start, size),
+          remaining_matches(max_matches),
+          partial_matches(pattern.size, false) {}
+
+    /**
+     * @brief Continues the scan to find the next match.
+     *
+     * @return The next match, without the pattern offset applied, or 0 if there are no more.
+     */
+    Address next_match(void) {
+        while (true) {
+            if (!this->chunk_started) {
+                if (this->chunk_idx >= this->reader.chunks().size()) {
+                    if (!this->reader.read()) {
+                        return 0;
+                    }
+                    this->chunk_idx = 0;
+                    continue;
+                }
+
+                const auto& chunk_info = this->reader.chunks()[this->chunk_idx];
+                if (chunk_info.address != this->last_chunk_end) {
+                    std::fill(this->partial_matches.begin(), this->partial_matches.end(), false);
+                }
+                this->last_chunk_end = chunk_info.address + chunk_info.size;
+
+                this->finished_matches.clear();
+                sigscan_finish_partial_matches(this->pattern.bytes, this->pattern.mask,
+                                               this->pattern.size, this->reader.data(chunk_info),
+                                               chunk_info.size, this->partial_matches,
+                                               this->finished_matches);
+
+                this->chunk_started = true;
+                this->finished_idx = 0;
+                this->chunk_offset = 0;
+            }
+
+            const auto& chunk_info = this->reader.chunks()[this->chunk_idx];
+            const auto* chunk = this->reader.data(chunk_info);
+
+            // Check for matches crossing the start of this chunk
+            if (this->finished_idx < this->finished_matches.size()) {
+                return chunk_info.address - this->finished_matches[this->finished_idx++];
+            }
+
+            // Check for matches within this chunk
+            if (chunk_info.size >= this->pattern.size) {
+                auto num_offsets = chunk_info.size - this->pattern.size + 1;
+                if (this->chunk_offset < num_offsets) {
+                    auto found = sigscan_find_in_chunk(
+                        this->pattern, this->anchor, this->skip_table, &chunk[this->chunk_offset],
+                        num_offsets - this->chunk_offset);
+
+                    if (found != SIGSCAN_NO_MATCH) {
+                        auto match_offset = this->chunk_offset + found;
+                        this->chunk_offset = match_offset + 1;
+                        return chunk_info.address + match_offset;
+                    }
+                    this->chunk_offset = num_offsets;
+                }
+            }
+
+            // Check for matches crossing over the end of this chunk
+            sigscan_find_partial_matches(this->pattern.bytes, this->pattern.mask,
+                                         this->pattern.size, chunk, chunk_info.size,
+                                         this->partial_matches);
+
+            this->chunk_started = false;
+            this->chunk_idx++;
+        }
+    }
+};
+
+SigscanRange::SigscanRange(ProcessId process,
+                           const PatternView& pattern,
+                           Address start,
+                           size_t size,
+                           size_t max_matches)
+    : state(std::make_unique<State>(process, pattern, start, size, max_matches)) {}
+
+SigscanRange::SigscanRange(SigscanRange&& other) noexcept = default;
+SigscanRange& SigscanRange::operator=(SigscanRange&& other) noexcept = default;
+SigscanRange::~SigscanRange(void) = default;
+
+Address SigscanRange::next(void) {
+    if (this->state->remaining_matches == 0) {
+        return 0;
+    }
+
+    auto addr = this->state->next_match();
+    if (addr == 0) {
+        this->state->remaining_matches = 0;
+        return 0;
+    }
+
+    this->state->remaining_matches--;
+    return addr + this->state->pattern.offset;
+}
+
 Address sigscan(ProcessId process,
                 const uint8_t* bytes,
                 const uint8_t* mask,
                 size_t pattern_size,
                 Address start,
                 size_t size) {
-    uint8_t chunk[SIGSCAN_CHUNK_SIZE];
-    std::vector<bool> partial_matches(pattern_size, false);
+    return sigscan(process, PatternView{bytes, mask, pattern_size, 0}, start, size);
+}
+
+Address sigscan(const ProcessInfo& process,
+                const uint8_t* bytes,
+                const uint8_t* mask,
+                size_t pattern_size) {
+    return sigscan(process, bytes, mask, pattern_size, process.main_module,
+                   process.main_module_size);
+}
+
+#ifdef ASR_UTILS_THREADS
+
+namespace {
+
+/*
+With threads, we split the range into slices, and have a few workers pick them off one at a time.
+Each slice extends one pattern length (minus one) into the next, so that a match crossing the
+boundary still gets found, by the earlier slice.
+
+To return the same result as a single threaded scan, we keep track of the lowest match found so far,
+and workers stop picking up new slices once they'd start after it.
+*/
+
+const constexpr size_t SIGSCAN_THREADED_MIN_SIZE = 0x400000;
+const constexpr size_t SIGSCAN_THREADED_MIN_SLICE_SIZE = 0x100000;
+const constexpr size_t SIGSCAN_THREADED_SLICES_PER_WORKER = 4;
+const constexpr size_t SIGSCAN_THREADED_MAX_WORKERS = 8;
+
+/**
+ * @brief Performs a sigscan, split over multiple threads.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return The found location, or 0 if not found.
+ */
+Address sigscan_threaded(ProcessId process,
+                         const PatternView& pattern,
+                         Address start,
+                         size_t size) {
+    // Some runtimes can't tell us how many cores there are, assume a couple
+    size_t num_workers = std::thread::hardware_concurrency();
+    num_workers = std::clamp<size_t>(num_workers == 0 ? 2 : num_workers, 1,
+                                     SIGSCAN_THREADED_MAX_WORKERS);
+
+    auto slice_size = std::max(SIGSCAN_THREADED_MIN_SLICE_SIZE,
+                               size / (num_workers * SIGSCAN_THREADED_SLICES_PER_WORKER));
+    auto num_slices = (size + slice_size - 1) / slice_size;
+    num_workers = std::min(num_workers, num_slices);
+
+    // Work without the offset, so we're comparing the actual match addresses
+    PatternView pattern_no_offset = pattern;
+    pattern_no_offset.offset = 0;
+
+    const Address no_match = std::numeric_limits<Address>::max();
+    std::atomic<size_t> next_slice{0};
+    std::atomic<Address> lowest_match{no_match};
+
+    auto worker = [&]() {
+        while (true) {
+            auto slice = next_slice.fetch_add(1);
+            if (slice >= num_slices) {
+                return;
+            }
+
+            auto slice_start = start + (slice * slice_size);
+            if (slice_start >= lowest_match.load()) {
+                return;
+            }
+
+            auto scan_size = std::min<size_t>(slice_size + pattern.size - 1,
+                                              (start + size) - slice_start);
+            auto addr =
+                SigscanRange{process, pattern_no_offset, slice_start, scan_size, 1}.next();
+            if (addr == 0) {
+                continue;
+            }
+
+            auto current = lowest_match.load();
+            while (addr < current && !lowest_match.compare_exchange_weak(current, addr)) {}
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_workers - 1);
+    for (size_t i = 1; i < num_workers; i++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto addr = lowest_match.load();
+    return addr == no_match ? 0 : addr + pattern.offset;
+}
+
+}  // namespace
+
+#endif
+
+Address sigscan(ProcessId process, const PatternView& pattern, Address start, size_t size) {
+#ifdef ASR_UTILS_THREADS
+    if (size >= SIGSCAN_THREADED_MIN_SIZE) {
+        return sigscan_threaded(process, pattern, start, size);
+    }
+#endif
+
+    return SigscanRange{process, pattern, start, size, 1}.next();
+}
+
+Address sigscan(const ProcessInfo& process, const PatternView& pattern) {
+    return sigscan(process, pattern, process.main_module, process.main_module_size);
+}
+
+std::optional<size_t> sigscan_buffer(const PatternView& pattern, std::span<const uint8_t> buffer) {
+    if (pattern.size == 0 || buffer.size() < pattern.size) {
+        return std::nullopt;
+    }
+
+    auto anchor = sigscan_pick_anchor(pattern.bytes, pattern.mask, pattern.size);
+    auto skip_table = sigscan_build_skip_table(pattern);
+    auto idx = sigscan_find_in_chunk(pattern, anchor, skip_table, buffer.data(),
+                                     buffer.size() - pattern.size + 1);
+    if (idx == SIGSCAN_NO_MATCH) {
+        return std::nullopt;
+    }
+    return idx;
+}
 
-    for (auto chunk_start = start; chunk_start < (start + size);
-         chunk_start += SIGSCAN_CHUNK_SIZE) {
-        if (!process_read(process, chunk_start, chunk)) {
-            return 0;
+namespace {
+
+/**
+ * @brief Performs a sigscan over a single section of the main module.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @param section The section to search.
+ * @return The found location, or 0 if not found.
+ */
+Address sigscan_section(const ProcessInfo& process,
+                        const PatternView& pattern,
+                        const ProcessInfo::Section& section) {
+    if (section.rva >= process.main_module_size) {
+        return 0;
+    }
+
+    // Some linkers leave the virtual size empty
+    auto size = section.size != 0 ? section.size : section.raw_size;
+    size = std::min<size_t>(size, process.main_module_size - section.rva);
+
+    return sigscan(process, pattern, process.main_module + section.rva, size);
+}
+
+}  // namespace
+
+Address sigscan(const ProcessInfo& process, const PatternView& pattern, std::string_view section) {
+    const auto* section_info = process.find_section(section);
+    if (section_info == nullptr) {
+        return 0;
+    }
+    return sigscan_section(process, pattern, *section_info);
+}
+
+Address sigscan_executable(const ProcessInfo& process, const PatternView& pattern) {
+    if (process.sections.empty()) {
+        return sigscan(process, pattern);
+    }
+
+    for (const auto& section : process.sections) {
+        if (!section.is_executable()) {
+            continue;
+        }
+        auto addr = sigscan_section(process, pattern, section);
+        if (addr != 0) {
+            return addr;
         }
+    }
+    return 0;
+}
+
+/*
+When scanning for multiple patterns at once, rather than running the single pattern search once per
+pattern (which would mean looking at every byte once per pattern again), we walk the chunk a single
+time, and use the byte at each offset to look up which patterns could start there. Only those get
+the full check.
+
+Matches crossing chunk boundaries are still handled per pattern, each one keeps it's own list of
+partial matches.
+*/
+
+struct SigscanJob::State {
+    std::vector<PatternView> patterns;
+    std::vector<Address> results;
+    size_t remaining_patterns;
+
+    std::array<std::vector<size_t>, std::numeric_limits<uint8_t>::max() + 1> by_first_byte{};
+    std::vector<std::vector<bool>> partial_matches{};
+    std::vector<size_t> finished_matches{};
+
+    SigscanReader reader;
+    Address last_chunk_end{0};
+
+    State(ProcessId process, std::span<const PatternView> patterns, Address start, size_t size)
+        : patterns(patterns.begin(), patterns.end()),
+          results(patterns.size(), 0),
+          remaining_patterns(patterns.size()),
+          reader(process, start, size) {
+        this->partial_matches.reserve(patterns.size());
+
+        for (size_t pattern_idx = 0; pattern_idx < patterns.size(); pattern_idx++) {
+            const auto& pattern = patterns[pattern_idx];
+            for (size_t byte = 0; byte < this->by_first_byte.size(); byte++) {
+                if ((byte & pattern.mask[0]) == pattern.bytes[0]) {
+                    this->by_first_byte[byte].push_back(pattern_idx);
+                }
+            }
+            this->partial_matches.emplace_back(pattern.size, false);
+        }
+    }
+
+    /**
+     * @brief Checks if the job is done.
+     *
+     * @return True if all patterns have been found, or if we've reached the end of the range.
+     */
+    [[nodiscard]] bool done(void) const {
+        return this->remaining_patterns == 0 || this->reader.remaining() == 0;
+    }
+
+    /**
+     * @brief Performs the next read, and scans through it.
+     *
+     * @param max_size The maximum amount of bytes to read.
+     */
+    void scan_next(size_t max_size) {
+        if (!this->reader.read(max_size)) {
+            return;
+        }
+
+        for (const auto& chunk_info : this->reader.chunks()) {
+            this->scan_chunk(chunk_info, this->reader.data(chunk_info));
+        }
+    }
+
+    /**
+     * @brief Scans through a single chunk.
+     *
+     * @param chunk_info The chunk's info.
+     * @param chunk The chunk's data.
+     */
+    void scan_chunk(const SigscanChunk& chunk_info, const uint8_t* chunk) {
+        auto contiguous = chunk_info.address == this->last_chunk_end;
+        this->last_chunk_end = chunk_info.address + chunk_info.size;
 
         // Check for matches crossing the start of this chunk
-        auto bytes_in_prefix =
-            sigscan_finish_partial_matches(bytes, mask, pattern_size, &chunk[0], partial_matches);
-        if (bytes_in_prefix != 0) {
-            return chunk_start - bytes_in_prefix;
+        for (size_t pattern_idx = 0; pattern_idx < this->patterns.size(); pattern_idx++) {
+            const auto& pattern = this->patterns[pattern_idx];
+            auto& pattern_partial_matches = this->partial_matches[pattern_idx];
+            if (this->results[pattern_idx] != 0) {
+                continue;
+            }
+            if (!contiguous) {
+                std::fill(pattern_partial_matches.begin(), pattern_partial_matches.end(), false);
+            }
+
+            this->finished_matches.clear();
+            sigscan_finish_partial_matches(pattern.bytes, pattern.mask, pattern.size, chunk,
+                                           chunk_info.size, pattern_partial_matches,
+                                           this->finished_matches);
+            if (!this->finished_matches.empty()) {
+                this->results[pattern_idx] =
+                    chunk_info.address - this->finished_matches.front() + pattern.offset;
+                this->remaining_patterns--;
+            }
         }
 
         // Check for matches within this chunk
-        auto end_of_chunk = std::min(chunk_start + SIGSCAN_CHUNK_SIZE - pattern_size, start + size);
-        for (size_t chunk_offset = 0; chunk_offset < (end_of_chunk - chunk_start); chunk_offset++) {
-            bool match = true;
-            for (size_t pattern_idx = 0; pattern_idx < pattern_size; pattern_idx++) {
-                if ((chunk[chunk_offset + pattern_idx] & mask[pattern_idx]) != bytes[pattern_idx]) {
-                    match = false;
-                    break;
+        for (size_t chunk_offset = 0;
+             chunk_offset < chunk_info.size && this->remaining_patterns > 0; chunk_offset++) {
+            for (auto pattern_idx : this->by_first_byte[chunk[chunk_offset]]) {
+                const auto& pattern = this->patterns[pattern_idx];
+                if (this->results[pattern_idx] != 0
+                    || chunk_offset + pattern.size > chunk_info.size) {
+                    continue;
+                }
+
+                if (sigscan_matches_at(pattern.bytes, pattern.mask, pattern.size,
+                                       &chunk[chunk_offset])) {
+                    this->results[pattern_idx] = chunk_info.address + chunk_offset + pattern.offset;
+                    this->remaining_patterns--;
                 }
-            }
-            if (match) {
-                return chunk_start + chunk_offset;
             }
         }
 
         // Check for matches crossing over the end of this chunk
-        sigscan_find_partial_matches(bytes, mask, pattern_size, &chunk[0], partial_matches);
+        for (size_t pattern_idx = 0; pattern_idx < this->patterns.size(); pattern_idx++) {
+            const auto& pattern = this->patterns[pattern_idx];
+            if (this->results[pattern_idx] != 0) {
+                continue;
+            }
+            sigscan_find_partial_matches(pattern.bytes, pattern.mask, pattern.size, chunk,
+                                         chunk_info.size, this->partial_matches[pattern_idx]);
+        }
     }
+};
 
-    return 0;
+SigscanJob::SigscanJob(ProcessId process,
+                       std::span<const PatternView> patterns,
+                       Address start,
+                       size_t size)
+    : state(std::make_unique<State>(process, patterns, start, size)) {}
+SigscanJob::SigscanJob(const ProcessInfo& process, std::span<const PatternView> patterns)
+    : SigscanJob(process, patterns, process.main_module, process.main_module_size) {}
+
+SigscanJob::SigscanJob(SigscanJob&& other) noexcept = default;
+SigscanJob& SigscanJob::operator=(SigscanJob&& other) noexcept = default;
+SigscanJob::~SigscanJob(void) = default;
+
+bool SigscanJob::step(size_t budget_bytes) {
+    while (!this->state->done() && budget_bytes > 0) {
+        auto remaining_before = this->state->reader.remaining();
+        this->state->scan_next(budget_bytes);
+        budget_bytes -= std::min(budget_bytes, remaining_before - this->state->reader.remaining());
+    }
+    return this->state->done();
 }
 
-Address sigscan(const ProcessInfo& process,
-                const uint8_t* bytes,
-                const uint8_t* mask,
-                size_t pattern_size) {
-    return sigscan(process, bytes, mask, pattern_size, process.main_module,
-                   process.main_module_size);
+bool SigscanJob::step(std::chrono::steady_clock::duration budget_time) {
+    auto end_time = std::chrono::steady_clock::now() + budget_time;
+    while (!this->state->done()) {
+        this->state->scan_next(std::numeric_limits<size_t>::max());
+        if (std::chrono::steady_clock::now() >= end_time) {
+            break;
+        }
+    }
+    return this->state->done();
+}
+
+bool SigscanJob::done(void) const {
+    return this->state->done();
+}
+
+size_t SigscanJob::bytes_remaining(void) const {
+    return this->state->done() ? 0 : this->state->reader.remaining();
+}
+
+std::span<const Address> SigscanJob::results(void) const {
+    return this->state->results;
+}
+
+void sigscan_many(ProcessId process,
+                  std::span<const PatternView> patterns,
+                  std::span<Address> results,
+                  Address start,
+                  size_t size) {
+    assert(patterns.size() == results.size());
+
+    SigscanJob job{process, patterns, start, size};
+    job.step(std::numeric_limits<size_t>::max());
+
+    auto job_results = job.results();
+    std::copy(job_results.begin(), job_results.end(), results.begin());
+}
+
+void sigscan_many(const ProcessInfo& process,
+                  std::span<const PatternView> patterns,
+                  std::span<Address> results) {
+    sigscan_many(process, patterns, results, process.main_module, process.main_module_size);
 }
 
 }  // namespace v0
@@ -7,14 +7,42 @@
 namespace asr_utils {
 inline namespace v0 {
 
+/**
+ * @brief The different algorithms which may be used to match a pattern.
+ */
+enum class PatternMatcher : uint8_t {
+    // Checks every offset against the full mask
+    MASKED,
+    // Pattern has no wildcards, so can use plain memchr/memcmp
+    SOLID,
+    // Pattern ends with a run of non-wildcard bytes, so can skip ahead using a Horspool table
+    HORSPOOL,
+};
+
+/**
+ * @brief Non-owning view of a sigscan pattern, erasing it's size.
+ * @note Only valid for the lifetime of the pattern it was created from.
+ */
+struct PatternView {
+    const uint8_t* bytes;
+    const uint8_t* mask;
+    size_t size;
+    ptrdiff_t offset;
+    PatternMatcher matcher{PatternMatcher::MASKED};
+};
+
 /**
  * @brief Struct holding information about a sigscan pattern.
  */
 template <size_t n>
 struct Pattern {
+    // The minimum number of trailing non-wildcard bytes for a Horspool search to be worth it
+    static const constexpr auto HORSPOOL_MIN_SOLID_SUFFIX = 4;
+
     std::array<uint8_t, n> bytes;
     std::array<uint8_t, n> mask;
     ptrdiff_t offset;
+    PatternMatcher matcher{PatternMatcher::MASKED};
 
     /**
      * @brief Construct a pattern.
@@ -25,12 +53,15 @@ struct Pattern {
      * @return A sigscan pattern.
      */
     Pattern(const uint8_t (&bytes)[n], const uint8_t (&mask)[n], ptrdiff_t offset = 0)
-        : bytes(bytes), mask(mask), offset(offset) {}
+        : bytes(std::to_array(bytes)), mask(std::to_array(mask)), offset(offset) {
+        this->pick_matcher();
+    }
     Pattern(const char (&bytes)[n + 1], const char (&mask)[n + 1], ptrdiff_t offset = 0)
-        : bytes(reinterpret_cast<const uint8_t*>(bytes)),
-          mask(reinterpret_cast<const uint8_t*>(mask)),
-          offset(offset) {
+        : bytes(), mask(), offset(offset) {
         static_assert(sizeof(uint8_t) == sizeof(char), "uint8_t is different size to char");
+        std::copy_n(reinterpret_cast<const uint8_t*>(bytes), n, this->bytes.begin());
+        std::copy_n(reinterpret_cast<const uint8_t*>(mask), n, this->mask.begin());
+        this->pick_matcher();
     }
 
     /**
@@ -100,6 +131,43 @@ struct Pattern {
             // since our vars aren't constexpr).
             std::abort();
         }
+
+        this->pick_matcher();
+    }
+
+    /**
+     * @brief Gets a size-erased view of this pattern.
+     *
+     * @return The pattern view.
+     */
+    [[nodiscard]] PatternView view(void) const {
+        return {this->bytes.data(), this->mask.data(), n, this->offset, this->matcher};
+    }
+
+   private:
+    /**
+     * @brief Picks the best algorithm to match this pattern with, based on it's wildcards.
+     * @note The Horspool skip table is only built when a scan starts, so patterns don't each carry
+     *       one around.
+     */
+    constexpr void pick_matcher(void) {
+        // NOLINTBEGIN(readability-magic-numbers)
+        size_t solid_suffix = 0;
+        while (solid_suffix < n && this->mask[n - solid_suffix - 1] == 0xFF) {
+            solid_suffix++;
+        }
+        // NOLINTEND(readability-magic-numbers)
+
+        if (solid_suffix == n) {
+            this->matcher = PatternMatcher::SOLID;
+            return;
+        }
+        if (solid_suffix < HORSPOOL_MIN_SOLID_SUFFIX) {
+            this->matcher = PatternMatcher::MASKED;
+            return;
+        }
+
+        this->matcher = PatternMatcher::HORSPOOL;
     }
 };
 
@@ -130,20 +198,322 @@ Address sigscan(ProcessId process,
                 const uint8_t* bytes,
                 const uint8_t* mask,
                 size_t pattern_size) = delete;
+Address sigscan(ProcessId process, const PatternView& pattern, Address start, size_t size);
+Address sigscan(const ProcessInfo& process, const PatternView& pattern);
+Address sigscan(ProcessId process, const PatternView& pattern) = delete;
 template <size_t n>
 Address sigscan(ProcessId process, const Pattern<n>& pattern, Address start, size_t size) {
-    auto addr = sigscan(process, pattern.bytes.data(), pattern.mask.data(), n, start, size);
-    return addr == 0 ? addr : addr + pattern.offset;
+    return sigscan(process, pattern.view(), start, size);
 }
 template <size_t n>
 Address sigscan(const ProcessInfo& process, const Pattern<n>& pattern) {
-    auto addr = sigscan(process, pattern.bytes.data(), pattern.mask.data(), n, process.main_module,
-                        process.main_module_size);
-    return addr == 0 ? addr : addr + pattern.offset;
+    return sigscan(process, pattern.view());
 }
 template <size_t n>
 Address sigscan(ProcessId process, const Pattern<n>& pattern) = delete;
 
+/**
+ * @brief Performs a sigscan over a local buffer.
+ * @note The pattern offset is not applied.
+ *
+ * @param pattern The pattern to search for.
+ * @param buffer The buffer to search through.
+ * @return The offset of the start of the first match within the buffer, or std::nullopt if not
+ *         found.
+ */
+std::optional<size_t> sigscan_buffer(const PatternView& pattern, std::span<const uint8_t> buffer);
+template <size_t n>
+std::optional<size_t> sigscan_buffer(const Pattern<n>& pattern, std::span<const uint8_t> buffer) {
+    return sigscan_buffer(pattern.view(), buffer);
+}
+
+/**
+ * @brief Performs a sigscan over a single section of the main module.
+ * @note Only supported for PE executables.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @param section The name of the section to search, e.g. `.text`.
+ * @return The found location, or 0 if not found or if the section doesn't exist.
+ */
+Address sigscan(const ProcessInfo& process, const PatternView& pattern, std::string_view section);
+template <size_t n>
+Address sigscan(const ProcessInfo& process, const Pattern<n>& pattern, std::string_view section) {
+    return sigscan(process, pattern.view(), section);
+}
+
+/**
+ * @brief Performs a sigscan over all executable sections of the main module.
+ * @note Falls back to scanning the entire main module if we don't know it's sections.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @return The found location, or 0 if not found.
+ */
+Address sigscan_executable(const ProcessInfo& process, const PatternView& pattern);
+Address sigscan_executable(ProcessId process, const PatternView& pattern) = delete;
+template <size_t n>
+Address sigscan_executable(const ProcessInfo& process, const Pattern<n>& pattern) {
+    return sigscan_executable(process, pattern.view());
+}
+template <size_t n>
+Address sigscan_executable(ProcessId process, const Pattern<n>& pattern) = delete;
+
+/**
+ * @brief Lazy range over every match of a sigscan.
+ * @note Each match includes the pattern's offset.
+ * @note This is a single pass input range, the scan resumes from where it left off every time you
+ *       advance it - beginning it a second time does not restart the scan.
+ */
+class SigscanRange {
+   private:
+    struct State;
+    std::unique_ptr<State> state;
+
+   public:
+    class Iterator {
+       private:
+        SigscanRange* range{nullptr};
+        Address current{0};
+
+       public:
+        using difference_type = ptrdiff_t;
+        using value_type = Address;
+
+        Iterator(void) = default;
+        explicit Iterator(SigscanRange* range) : range(range), current(range->next()) {}
+
+        [[nodiscard]] Address operator*(void) const { return this->current; }
+        Iterator& operator++(void) {
+            this->current = this->range->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        [[nodiscard]] bool operator==(std::default_sentinel_t /*end*/) const {
+            return this->current == 0;
+        }
+    };
+
+    /**
+     * @brief Constructs a new sigscan range.
+     * @note The pattern must outlive the range.
+     *
+     * @param process The process to search through.
+     * @param pattern The pattern to search for.
+     * @param start The address to start the search at.
+     * @param size The length of the region to search.
+     * @param max_matches The maximum amount of matches to find, after which the range ends early.
+     */
+    SigscanRange(ProcessId process,
+                 const PatternView& pattern,
+                 Address start,
+                 size_t size,
+                 size_t max_matches = std::numeric_limits<size_t>::max());
+
+    SigscanRange(const SigscanRange& other) = delete;
+    SigscanRange(SigscanRange&& other) noexcept;
+    SigscanRange& operator=(const SigscanRange& other) = delete;
+    SigscanRange& operator=(SigscanRange&& other) noexcept;
+    ~SigscanRange(void);
+
+    /**
+     * @brief Continues the scan to find the next match.
+     *
+     * @return The next match, or 0 if there are no more.
+     */
+    Address next(void);
+
+    /**
+     * @brief Gets iterators over the remaining matches.
+     *
+     * @return The begin iterator/end sentinel.
+     */
+    [[nodiscard]] Iterator begin(void) { return Iterator{this}; }
+    [[nodiscard]] std::default_sentinel_t end(void) const { return {}; }
+};
+
+/**
+ * @brief Lazily finds every match of a sigscan.
+ * @note The pattern must outlive the returned range.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param max_matches The maximum amount of matches to find, after which the range ends early.
+ * @return A range over all matches.
+ */
+template <size_t n>
+SigscanRange sigscan_all(ProcessId process,
+                         const Pattern<n>& pattern,
+                         Address start,
+                         size_t size,
+                         size_t max_matches = std::numeric_limits<size_t>::max()) {
+    return {process, pattern.view(), start, size, max_matches};
+}
+template <size_t n>
+SigscanRange sigscan_all(const ProcessInfo& process,
+                         const Pattern<n>& pattern,
+                         size_t max_matches = std::numeric_limits<size_t>::max()) {
+    return {process, pattern.view(), process.main_module, process.main_module_size, max_matches};
+}
+template <size_t n>
+SigscanRange sigscan_all(ProcessId process,
+                         const Pattern<n>& pattern,
+                         size_t max_matches = std::numeric_limits<size_t>::max()) = delete;
+
+/**
+ * @brief Performs a sigscan, which only succeeds if the pattern matches exactly once.
+ *
+ * @param process The process to search through.
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return The found location, or 0 if not found or if there were multiple matches.
+ */
+template <size_t n>
+Address sigscan_unique(ProcessId process, const Pattern<n>& pattern, Address start, size_t size) {
+    SigscanRange range{process, pattern.view(), start, size, 2};
+    auto addr = range.next();
+    return range.next() == 0 ? addr : 0;
+}
+template <size_t n>
+Address sigscan_unique(const ProcessInfo& process, const Pattern<n>& pattern) {
+    return sigscan_unique(process, pattern, process.main_module, process.main_module_size);
+}
+template <size_t n>
+Address sigscan_unique(ProcessId process, const Pattern<n>& pattern) = delete;
+
+/**
+ * @brief A sigscan for one or more patterns, which can be spread out over multiple ticks.
+ * @note Each result includes it's pattern's offset.
+ */
+class SigscanJob {
+   private:
+    struct State;
+    std::unique_ptr<State> state;
+
+   public:
+    /**
+     * @brief Constructs a new sigscan job.
+     * @note The patterns must outlive the job.
+     *
+     * @tparam n The sizes of each pattern - should be picked up automatically.
+     * @param process The process to search through.
+     * @param patterns The patterns to search for.
+     * @param start The address to start the search at.
+     * @param size The length of the region to search.
+     */
+    SigscanJob(ProcessId process,
+               std::span<const PatternView> patterns,
+               Address start,
+               size_t size);
+    SigscanJob(const ProcessInfo& process, std::span<const PatternView> patterns);
+    SigscanJob(ProcessId process, std::span<const PatternView> patterns) = delete;
+    template <size_t... n>
+    explicit SigscanJob(const ProcessInfo& process, const Pattern<n>&... patterns)
+        : SigscanJob(process, std::array<PatternView, sizeof...(n)>{patterns.view()...}) {}
+
+    SigscanJob(const SigscanJob& other) = delete;
+    SigscanJob(SigscanJob&& other) noexcept;
+    SigscanJob& operator=(const SigscanJob& other) = delete;
+    SigscanJob& operator=(SigscanJob&& other) noexcept;
+    ~SigscanJob(void);
+
+    /**
+     * @brief Continues the scan, stopping after roughly the given budget.
+     * @note Time budgets are checked between reads, so may overrun slightly.
+     *
+     * @param budget_bytes The maximum amount of memory to scan.
+     * @param budget_time The amount of time to scan for.
+     * @return True if the job is done.
+     */
+    bool step(size_t budget_bytes);
+    bool step(std::chrono::steady_clock::duration budget_time);
+
+    /**
+     * @brief Checks if the job is done.
+     *
+     * @return True if all patterns have been found, or if the entire range has been scanned.
+     */
+    [[nodiscard]] bool done(void) const;
+
+    /**
+     * @brief Gets how many bytes are left to scan.
+     *
+     * @return The remaining bytes.
+     */
+    [[nodiscard]] size_t bytes_remaining(void) const;
+
+    /**
+     * @brief Gets the results of the scan.
+     * @note Only valid for the lifetime of the job.
+     *
+     * @return The found locations, in the same order as the patterns, or 0 for each not found yet.
+     */
+    [[nodiscard]] std::span<const Address> results(void) const;
+};
+
+/**
+ * @brief Performs a sigscan for multiple patterns at once, only walking over memory once.
+ * @note Each result includes it's pattern's offset.
+ *
+ * @param process The process to search through.
+ * @param patterns The patterns to search for.
+ * @param results Output span to write the results to. Must be the same size as the patterns. Gets
+ *                the found locations, in the same order as the patterns, or 0 for each not found.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ */
+void sigscan_many(ProcessId process,
+                  std::span<const PatternView> patterns,
+                  std::span<Address> results,
+                  Address start,
+                  size_t size);
+void sigscan_many(const ProcessInfo& process,
+                  std::span<const PatternView> patterns,
+                  std::span<Address> results);
+void sigscan_many(ProcessId process,
+                  std::span<const PatternView> patterns,
+                  std::span<Address> results) = delete;
+
+/**
+ * @brief Performs a sigscan for multiple patterns at once, only walking over memory once.
+ * @note Each result includes it's pattern's offset.
+ *
+ * @tparam n The sizes of each pattern - should be picked up automatically.
+ * @param process The process to search through.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param patterns The patterns to search for.
+ * @return The found locations, in the same order as the patterns, or 0 for each not found.
+ */
+template <size_t... n>
+std::array<Address, sizeof...(n)> sigscan_many(ProcessId process,
+                                                Address start,
+                                                size_t size,
+                                                const Pattern<n>&... patterns) {
+    const std::array<PatternView, sizeof...(n)> views{patterns.view()...};
+    std::array<Address, sizeof...(n)> results{};
+    sigscan_many(process, views, results, start, size);
+    return results;
+}
+/**
+ * @brief Performs a sigscan for multiple patterns at once over the main module, only walking over
+ *        memory once.
+ * @note Each result includes it's pattern's offset.
+ *
+ * @tparam n The sizes of each pattern - should be picked up automatically.
+ * @param process The process to search through.
+ * @param patterns The patterns to search for.
+ * @return The found locations, in the same order as the patterns, or 0 for each not found.
+ */
+template <size_t... n>
+std::array<Address, sizeof...(n)> sigscan_many(const ProcessInfo& process,
+                                                const Pattern<n>&... patterns) {
+    return sigscan_many(process, process.main_module, process.main_module_size, patterns...);
+}
+
 }  // namespace v0
 }  // namespace asr_utils
 
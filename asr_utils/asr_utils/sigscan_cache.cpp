@@ -0,0 +1,238 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/sigscan_cache.h"
+#include "asr_utils/asr_extensions.h"
+#include "asr_utils/internal/unique_file.h"
+#include "asr_utils/sigscan.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+namespace {
+
+/*
+The cache file is a simple binary format, in native endianness:
+
+    magic           8 bytes
+    module size     u64
+    pe timestamp    u32
+    pe checksum     u32
+    entry count     u32
+    entries...
+
+Each entry is:
+
+    pattern size    u32
+    bytes           pattern size bytes
+    mask            pattern size bytes
+    rva             u64
+
+The files are tiny, so rather than hashing patterns we just store them in full.
+*/
+
+const constexpr std::array<char, 8> CACHE_MAGIC = {'A', 'S', 'R', 'S', 'I', 'G', '0', '1'};
+
+/**
+ * @brief Helper to read a single value from a file.
+ *
+ * @tparam T The type of the value.
+ * @param file The file to read from.
+ * @param val The value to read into.
+ * @return True on success.
+ */
+template <typename T>
+bool read_value(FILE* file, T& val) {
+    return fread(&val, sizeof(T), 1, file) == 1;
+}
+
+/**
+ * @brief Helper to write a single value to a file.
+ *
+ * @tparam T The type of the value.
+ * @param file The file to write to.
+ * @param val The value to write.
+ * @return True on success.
+ */
+template <typename T>
+bool write_value(FILE* file, const T& val) {
+    return fwrite(&val, sizeof(T), 1, file) == 1;
+}
+
+}  // namespace
+
+SigscanCache::SigscanCache(const ProcessInfo& process, std::string_view path)
+    : path(path),
+      enabled(process.exe_format == ProcessInfo::ExecutableFormat::PE),
+      module_size(process.main_module_size),
+      pe_timestamp(process.pe_timestamp),
+      pe_checksum(process.pe_checksum) {
+    if (this->enabled) {
+        this->load();
+    }
+}
+
+// The moved from cache must not save on destruction, it no longer has a path or any entries
+SigscanCache::SigscanCache(SigscanCache&& other) noexcept
+    : path(std::move(other.path)),
+      enabled(std::exchange(other.enabled, false)),
+      dirty(std::exchange(other.dirty, false)),
+      module_size(other.module_size),
+      pe_timestamp(other.pe_timestamp),
+      pe_checksum(other.pe_checksum),
+      entries(std::move(other.entries)) {}
+
+SigscanCache& SigscanCache::operator=(SigscanCache&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (this->dirty) {
+        this->save();
+    }
+
+    this->path = std::move(other.path);
+    this->enabled = std::exchange(other.enabled, false);
+    this->dirty = std::exchange(other.dirty, false);
+    this->module_size = other.module_size;
+    this->pe_timestamp = other.pe_timestamp;
+    this->pe_checksum = other.pe_checksum;
+    this->entries = std::move(other.entries);
+    return *this;
+}
+
+SigscanCache::~SigscanCache(void) {
+    if (this->dirty) {
+        this->save();
+    }
+}
+
+void SigscanCache::load(void) {
+    internal::UniqueFile file{fopen(this->path.c_str(), "rb")};
+    if (!file) {
+        return;
+    }
+
+    std::array<char, CACHE_MAGIC.size()> magic{};
+    uint64_t module_size{};
+    uint32_t pe_timestamp{};
+    uint32_t pe_checksum{};
+    uint32_t num_entries{};
+    if (!read_value(file.get(), magic) || magic != CACHE_MAGIC
+        || !read_value(file.get(), module_size) || !read_value(file.get(), pe_timestamp)
+        || !read_value(file.get(), pe_checksum) || !read_value(file.get(), num_entries)) {
+        return;
+    }
+
+    // If the executable's changed, all the old results are useless, throw them away
+    if (module_size != this->module_size || pe_timestamp != this->pe_timestamp
+        || pe_checksum != this->pe_checksum) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < num_entries; i++) {
+        uint32_t pattern_size{};
+        if (!read_value(file.get(), pattern_size) || pattern_size > this->module_size) {
+            break;
+        }
+
+        Entry entry{std::vector<uint8_t>(pattern_size), std::vector<uint8_t>(pattern_size), 0};
+        if (fread(entry.bytes.data(), 1, pattern_size, file.get()) != pattern_size
+            || fread(entry.mask.data(), 1, pattern_size, file.get()) != pattern_size
+            || !read_value(file.get(), entry.rva)) {
+            break;
+        }
+        this->entries.push_back(std::move(entry));
+    }
+}
+
+bool SigscanCache::save(void) {
+    if (!this->enabled) {
+        return false;
+    }
+
+    internal::UniqueFile file{fopen(this->path.c_str(), "wb")};
+    if (!file) {
+        runtime_print_message("Failed to open sigscan cache '{}' for writing", this->path);
+        return false;
+    }
+
+    bool success = write_value(file.get(), CACHE_MAGIC)
+                   && write_value(file.get(), this->module_size)
+                   && write_value(file.get(), this->pe_timestamp)
+                   && write_value(file.get(), this->pe_checksum)
+                   && write_value(file.get(), static_cast<uint32_t>(this->entries.size()));
+
+    for (const auto& entry : this->entries) {
+        if (!success) {
+            break;
+        }
+        auto pattern_size = static_cast<uint32_t>(entry.bytes.size());
+        success = write_value(file.get(), pattern_size)
+                  && fwrite(entry.bytes.data(), 1, pattern_size, file.get()) == pattern_size
+                  && fwrite(entry.mask.data(), 1, pattern_size, file.get()) == pattern_size
+                  && write_value(file.get(), entry.rva);
+    }
+
+    if (!success) {
+        runtime_print_message("Failed to write sigscan cache '{}'", this->path);
+        return false;
+    }
+
+    this->dirty = false;
+    return true;
+}
+
+SigscanCache::Entry* SigscanCache::find_entry(const PatternView& pattern) {
+    for (auto& entry : this->entries) {
+        if (entry.bytes.size() == pattern.size
+            && std::equal(entry.bytes.begin(), entry.bytes.end(), pattern.bytes)
+            && std::equal(entry.mask.begin(), entry.mask.end(), pattern.mask)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+Address SigscanCache::sigscan(const ProcessInfo& process, const PatternView& pattern) {
+    auto* entry = this->enabled ? this->find_entry(pattern) : nullptr;
+
+    if (entry != nullptr) {
+        // Only need to verify the bytes at the cached address
+        auto cached_addr = process.main_module + entry->rva;
+        std::vector<uint8_t> buf(pattern.size);
+        if (process_read(process, cached_addr, buf.data(), buf.size())) {
+            bool match = true;
+            for (size_t pattern_idx = 0; pattern_idx < pattern.size; pattern_idx++) {
+                if ((buf[pattern_idx] & pattern.mask[pattern_idx]) != pattern.bytes[pattern_idx]) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) {
+                return cached_addr + pattern.offset;
+            }
+        }
+    }
+
+    // Scan without the offset, since we always want to store the start of the match
+    PatternView pattern_no_offset = pattern;
+    pattern_no_offset.offset = 0;
+    auto addr = asr_utils::sigscan(process, pattern_no_offset);
+    if (addr == 0) {
+        return 0;
+    }
+
+    if (this->enabled) {
+        if (entry != nullptr) {
+            entry->rva = addr - process.main_module;
+        } else {
+            this->entries.push_back({{pattern.bytes, pattern.bytes + pattern.size},
+                                     {pattern.mask, pattern.mask + pattern.size},
+                                     addr - process.main_module});
+        }
+        this->dirty = true;
+    }
+
+    return addr + pattern.offset;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
@@ -0,0 +1,99 @@
+#ifndef ASR_UTILS_SIGSCAN_CACHE_H
+#define ASR_UTILS_SIGSCAN_CACHE_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/sigscan.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief Persistent cache of sigscan results, stored in a file through WASI.
+ * @note Results are stored relative to the main module, and keyed on the executable's size, PE
+ *       timestamp and PE checksum, as well as the full pattern. Only works for PE executables,
+ *       anything else always scans.
+ * @note Cached results are verified before being returned, so an outdated cache will never give a
+ *       wrong result, it'll just transparently scan again.
+ */
+class SigscanCache {
+   private:
+    struct Entry {
+        std::vector<uint8_t> bytes;
+        std::vector<uint8_t> mask;
+        Address rva;
+    };
+
+    std::string path;
+    bool enabled{false};
+    bool dirty{false};
+
+    uint64_t module_size{0};
+    uint32_t pe_timestamp{0};
+    uint32_t pe_checksum{0};
+    std::vector<Entry> entries;
+
+    /**
+     * @brief Loads the cache file, if it exists and matches the current executable.
+     */
+    void load(void);
+
+    /**
+     * @brief Finds the cache entry for a pattern.
+     *
+     * @param pattern The pattern to look for.
+     * @return A pointer to the entry, or nullptr if the pattern isn't cached.
+     */
+    Entry* find_entry(const PatternView& pattern);
+
+   public:
+    /**
+     * @brief Constructs a new sigscan cache, loading any existing results.
+     *
+     * @param process The process which will be scanned.
+     * @param path The path of the file to store the cache in.
+     */
+    SigscanCache(const ProcessInfo& process, std::string_view path);
+
+    SigscanCache(const SigscanCache& other) = delete;
+    SigscanCache(SigscanCache&& other) noexcept;
+    SigscanCache& operator=(const SigscanCache& other) = delete;
+    /**
+     * @brief Move assigns a cache, saving any new results of the one being replaced first.
+     */
+    SigscanCache& operator=(SigscanCache&& other) noexcept;
+
+    /**
+     * @brief Destroys the cache, saving any new results.
+     */
+    ~SigscanCache(void);
+
+    /**
+     * @brief Performs a sigscan over the main module, using the cached result if it's still valid.
+     *
+     * @param process The process to search through.
+     * @param pattern The pattern to search for.
+     * @return The found location, or 0 if not found.
+     */
+    Address sigscan(const ProcessInfo& process, const PatternView& pattern);
+    Address sigscan(ProcessId process, const PatternView& pattern) = delete;
+    template <size_t n>
+    Address sigscan(const ProcessInfo& process, const Pattern<n>& pattern) {
+        return this->sigscan(process, pattern.view());
+    }
+    template <size_t n>
+    Address sigscan(ProcessId process, const Pattern<n>& pattern) = delete;
+
+    /**
+     * @brief Writes all results to the cache file.
+     * @note Automatically called on destruction if there are any new results.
+     *
+     * @return True if the file was written successfully.
+     */
+    bool save(void);
+};
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_SIGSCAN_CACHE_H */
@@ -0,0 +1,200 @@
+#ifndef ASR_UTILS_TYPED_PROCESS_H
+#define ASR_UTILS_TYPED_PROCESS_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief A view of a process with it's pointer size and endianness fixed at compile time.
+ * @note The helpers on this class compile without any of the runtime pointer size or endianness
+ *       branches the `ProcessInfo` versions have. Use `with_typed_process` to get one.
+ * @note Only valid for the lifetime of the underlying `ProcessInfo`.
+ *
+ * @tparam PointerT The process's pointer type, `uint32_t` or `uint64_t`.
+ * @tparam endian The process's endianness.
+ */
+template <typename PointerT, std::endian endian>
+class TypedProcess {
+   private:
+    static_assert(std::is_same_v<PointerT, uint32_t> || std::is_same_v<PointerT, uint64_t>,
+                  "pointer type must be uint32_t or uint64_t");
+
+    const ProcessInfo* process;
+
+   public:
+    using Pointer = PointerT;
+    static const constexpr bool IS_64_BIT = std::is_same_v<PointerT, uint64_t>;
+    static const constexpr std::endian ENDIANNESS = endian;
+
+    /**
+     * @brief Constructs a new typed process view.
+     *
+     * @param process The process to view. Must match the pointer size and endianness.
+     */
+    explicit TypedProcess(const ProcessInfo& process) : process(&process) {
+        assert(process.is_64_bit == IS_64_BIT && process.endianness == endian);
+    }
+    explicit TypedProcess(ProcessId process) = delete;
+
+    /**
+     * @brief Gets the underlying process info.
+     *
+     * @return The process info.
+     */
+    [[nodiscard]] const ProcessInfo& info(void) const { return *this->process; }
+
+    /**
+     * @brief Implicitly casts to the associated process id.
+     *
+     * @return The process id.
+     */
+    operator ProcessId(void) const { return this->process->pid; }
+
+    /**
+     * @brief Ensures the provided value is in native endianness.
+     *
+     * @tparam T The type of the value.
+     * @param val The value.
+     * @return The value in native endianness.
+     */
+    template <typename T>
+    [[nodiscard]] T fix_endianness(T val) const {
+        if constexpr (endian != std::endian::native) {
+            return swap_endianness(val);
+        } else {
+            return val;
+        }
+    }
+
+    /**
+     * @brief Reads memory from the process, through it's page cache if enabled.
+     *
+     * @param address The address to read memory at.
+     * @param buf The buffer to read into.
+     * @param size The amount of bytes to read.
+     * @return True on success, false on failure.
+     */
+    bool read_mem(Address address, uint8_t* buf, size_t size) const {
+        return asr_utils::read_mem(*this->process, address, buf, size);
+    }
+
+    /**
+     * @brief Reads a value from the process.
+     * @note Retains the process endianness.
+     *
+     * @tparam T The type of the value.
+     * @param address The address to read memory at.
+     * @return The read value, or it's default constructed version if the read fails.
+     */
+    template <typename T>
+    [[nodiscard]] T read_mem(Address address) const {
+        T val{};
+        this->read_mem(address, reinterpret_cast<uint8_t*>(&val), sizeof(T));
+        return val;
+    }
+
+    /**
+     * @brief Reads a pointer sized address from the process.
+     *
+     * @param address The address to read memory at.
+     * @return The address, or 0 if the read fails.
+     */
+    [[nodiscard]] Address read_address(Address address) const {
+        return this->fix_endianness(this->read_mem<PointerT>(address));
+    }
+
+    /**
+     * @brief Reads an x86 assembly pointer offset, and gets the address it points to.
+     * @note Used for `mov [<address>], rax` style instructions.
+     *
+     * @param address The address of the offset to read.
+     * @return The address it points to, or 0 if the read failed.
+     */
+    [[nodiscard]] Address read_x86_offset(Address address) const {
+        // Instructions are always little endian, whatever the process's data is
+        if constexpr (IS_64_BIT) {
+            // x64 encodes it relative to the end of the offset
+            int32_t offset{};
+            if (!this->read_mem(address, reinterpret_cast<uint8_t*>(&offset), sizeof(offset))) {
+                return 0;
+            }
+            if constexpr (std::endian::native != std::endian::little) {
+                offset = swap_endianness(offset);
+            }
+            return address + static_cast<Address>(offset) + sizeof(offset);
+        } else {
+            uint32_t new_addr{};
+            if (!this->read_mem(address, reinterpret_cast<uint8_t*>(&new_addr), sizeof(new_addr))) {
+                return 0;
+            }
+            if constexpr (std::endian::native != std::endian::little) {
+                new_addr = swap_endianness(new_addr);
+            }
+            return new_addr;
+        }
+    }
+
+    /**
+     * @brief Dereferences a multi-step pointer path.
+     *
+     * @param base The address to start at.
+     * @param offsets The offsets to follow.
+     * @return The final dereferenced address, or 0 if any part of the path was invalid.
+     */
+    [[nodiscard]] Address dereference(Address base, std::span<const ptrdiff_t> offsets) const {
+        auto addr = this->read_address(base);
+        if (offsets.empty()) {
+            return addr;
+        }
+
+        if (addr == 0) {
+            return 0;
+        }
+
+        for (size_t i = 0; i < (offsets.size() - 1); i++) {
+            addr = this->read_address(addr + offsets[i]);
+            if (addr == 0) {
+                return 0;
+            }
+        }
+
+        return addr + offsets.back();
+    }
+};
+
+using TypedProcess32 = TypedProcess<uint32_t, std::endian::little>;
+using TypedProcess64 = TypedProcess<uint64_t, std::endian::little>;
+using TypedProcess32BE = TypedProcess<uint32_t, std::endian::big>;
+using TypedProcess64BE = TypedProcess<uint64_t, std::endian::big>;
+
+/**
+ * @brief Calls a function with the typed view matching a process.
+ * @note This is the single point where the runtime pointer size and endianness get checked, so
+ *       ideally wrap as much of your update logic in it as possible.
+ *
+ * @tparam Func The function type.
+ * @param process The process to view.
+ * @param func The function to call. Must accept any `TypedProcess`, and give the same return type
+ *             for all of them.
+ * @return The function's return value.
+ */
+template <typename Func>
+decltype(auto) with_typed_process(const ProcessInfo& process, Func&& func) {
+    if (process.endianness == std::endian::little) {
+        return process.is_64_bit ? std::forward<Func>(func)(TypedProcess64{process})
+                                 : std::forward<Func>(func)(TypedProcess32{process});
+    }
+    return process.is_64_bit ? std::forward<Func>(func)(TypedProcess64BE{process})
+                             : std::forward<Func>(func)(TypedProcess32BE{process});
+}
+template <typename Func>
+decltype(auto) with_typed_process(ProcessId process, Func&& func) = delete;
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_TYPED_PROCESS_H */
@@ -0,0 +1,478 @@
+#include "asr_utils/pch.h"
+#include "asr_utils/x86_decoder.h"
+#include "asr_utils/read_mem.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+namespace {
+
+/*
+This is a length decoder, not a full disassembler. We only care about how long each instruction is,
+and where it's displacement and immediate are, so each opcode just gets a set of flags saying which
+of those it has.
+
+Sizes are decided by the prefixes, so we track those as we go - operand size affects `iz`/`iv`
+immediates, address size affects ModRM and `moffs`. REX only matters for it's W bit, and only if
+it's directly before the opcode. VEX/EVEX prefixes just select an opcode map, which we then look up
+the same as the legacy escapes.
+
+Since x86 is always little endian, values are assembled byte by byte rather than memcpy'd.
+*/
+
+const constexpr size_t X86_MAX_INSTRUCTION_LENGTH = 15;
+const constexpr Address X86_PAGE_SIZE = 0x1000;
+
+using OpcodeFlags = uint8_t;
+const constexpr OpcodeFlags OP_MODRM = 1 << 0;
+const constexpr OpcodeFlags OP_IMM8 = 1 << 1;
+const constexpr OpcodeFlags OP_IMM16 = 1 << 2;
+// 16 or 32 bits, based on operand size
+const constexpr OpcodeFlags OP_IMMZ = 1 << 3;
+// 16, 32 or 64 bits, based on operand size
+const constexpr OpcodeFlags OP_IMMV = 1 << 4;
+// An absolute address, based on address size
+const constexpr OpcodeFlags OP_MOFFS = 1 << 5;
+// The immediate is a relative branch target
+const constexpr OpcodeFlags OP_REL = 1 << 6;
+// F6/F7, which only have an immediate for `test`
+const constexpr OpcodeFlags OP_GROUP3 = 1 << 7;
+
+using OpcodeTable = std::array<OpcodeFlags, 256>;
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+/**
+ * @brief Builds the flags table for the one byte opcode map.
+ *
+ * @return The table.
+ */
+constexpr OpcodeTable make_one_byte_table(void) {
+    OpcodeTable table{};
+
+    // The first four rows of arithmetic ops all follow the same layout
+    for (size_t base = 0x00; base < 0x40; base += 0x08) {
+        table[base + 0] = OP_MODRM;
+        table[base + 1] = OP_MODRM;
+        table[base + 2] = OP_MODRM;
+        table[base + 3] = OP_MODRM;
+        table[base + 4] = OP_IMM8;
+        table[base + 5] = OP_IMMZ;
+    }
+
+    table[0x62] = OP_MODRM;
+    table[0x63] = OP_MODRM;
+    table[0x68] = OP_IMMZ;
+    table[0x69] = OP_MODRM | OP_IMMZ;
+    table[0x6A] = OP_IMM8;
+    table[0x6B] = OP_MODRM | OP_IMM8;
+    for (size_t opcode = 0x70; opcode <= 0x7F; opcode++) {
+        table[opcode] = OP_IMM8 | OP_REL;
+    }
+    table[0x80] = OP_MODRM | OP_IMM8;
+    table[0x81] = OP_MODRM | OP_IMMZ;
+    table[0x82] = OP_MODRM | OP_IMM8;
+    table[0x83] = OP_MODRM | OP_IMM8;
+    for (size_t opcode = 0x84; opcode <= 0x8F; opcode++) {
+        table[opcode] = OP_MODRM;
+    }
+    table[0x9A] = OP_IMMZ | OP_IMM16;
+    for (size_t opcode = 0xA0; opcode <= 0xA3; opcode++) {
+        table[opcode] = OP_MOFFS;
+    }
+    table[0xA8] = OP_IMM8;
+    table[0xA9] = OP_IMMZ;
+    for (size_t opcode = 0xB0; opcode <= 0xB7; opcode++) {
+        table[opcode] = OP_IMM8;
+    }
+    for (size_t opcode = 0xB8; opcode <= 0xBF; opcode++) {
+        table[opcode] = OP_IMMV;
+    }
+    table[0xC0] = OP_MODRM | OP_IMM8;
+    table[0xC1] = OP_MODRM | OP_IMM8;
+    table[0xC2] = OP_IMM16;
+    table[0xC4] = OP_MODRM;
+    table[0xC5] = OP_MODRM;
+    table[0xC6] = OP_MODRM | OP_IMM8;
+    table[0xC7] = OP_MODRM | OP_IMMZ;
+    table[0xC8] = OP_IMM16 | OP_IMM8;
+    table[0xCA] = OP_IMM16;
+    table[0xCD] = OP_IMM8;
+    for (size_t opcode = 0xD0; opcode <= 0xD3; opcode++) {
+        table[opcode] = OP_MODRM;
+    }
+    table[0xD4] = OP_IMM8;
+    table[0xD5] = OP_IMM8;
+    for (size_t opcode = 0xD8; opcode <= 0xDF; opcode++) {
+        table[opcode] = OP_MODRM;
+    }
+    for (size_t opcode = 0xE0; opcode <= 0xE3; opcode++) {
+        table[opcode] = OP_IMM8 | OP_REL;
+    }
+    for (size_t opcode = 0xE4; opcode <= 0xE7; opcode++) {
+        table[opcode] = OP_IMM8;
+    }
+    table[0xE8] = OP_IMMZ | OP_REL;
+    table[0xE9] = OP_IMMZ | OP_REL;
+    table[0xEA] = OP_IMMZ | OP_IMM16;
+    table[0xEB] = OP_IMM8 | OP_REL;
+    table[0xF6] = OP_MODRM | OP_GROUP3;
+    table[0xF7] = OP_MODRM | OP_GROUP3;
+    table[0xFE] = OP_MODRM;
+    table[0xFF] = OP_MODRM;
+
+    return table;
+}
+
+/**
+ * @brief Builds the flags table for the two byte (0F) opcode map.
+ *
+ * @return The table.
+ */
+constexpr OpcodeTable make_two_byte_table(void) {
+    OpcodeTable table{};
+
+    // Almost everything takes a ModRM, so clear out the few which don't
+    table.fill(OP_MODRM);
+    for (auto opcode : {0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E, 0x39, 0x77,
+                        0xA0, 0xA1, 0xA2, 0xA8, 0xA9, 0xAA}) {
+        table[opcode] = 0;
+    }
+    for (size_t opcode = 0x30; opcode <= 0x3F; opcode++) {
+        table[opcode] = 0;
+    }
+    for (size_t opcode = 0xC8; opcode <= 0xCF; opcode++) {
+        table[opcode] = 0;
+    }
+
+    for (size_t opcode = 0x80; opcode <= 0x8F; opcode++) {
+        table[opcode] = OP_IMMZ | OP_REL;
+    }
+    for (auto opcode : {0x0F, 0x70, 0x71, 0x72, 0x73, 0xA4, 0xAC, 0xBA, 0xC2, 0xC4, 0xC5, 0xC6}) {
+        table[opcode] = OP_MODRM | OP_IMM8;
+    }
+
+    return table;
+}
+
+const constexpr auto ONE_BYTE_TABLE = make_one_byte_table();
+const constexpr auto TWO_BYTE_TABLE = make_two_byte_table();
+const constexpr OpcodeFlags THREE_BYTE_38_FLAGS = OP_MODRM;
+const constexpr OpcodeFlags THREE_BYTE_3A_FLAGS = OP_MODRM | OP_IMM8;
+
+/**
+ * @brief Checks if a byte is a legacy prefix.
+ *
+ * @param byte The byte to check.
+ * @return True if it's a prefix.
+ */
+bool is_legacy_prefix(uint8_t byte) {
+    switch (byte) {
+        case 0xF0:
+        case 0xF2:
+        case 0xF3:
+        case 0x26:
+        case 0x2E:
+        case 0x36:
+        case 0x3E:
+        case 0x64:
+        case 0x65:
+        case 0x66:
+        case 0x67:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Reads a little endian value out of a buffer.
+ *
+ * @param data The data to read.
+ * @param size The size of the value, in bytes. At most 8.
+ * @return The value.
+ */
+uint64_t read_little_endian(const uint8_t* data, size_t size) {
+    uint64_t val = 0;
+    for (size_t i = size; i-- > 0;) {
+        val = (val << 8) | data[i];
+    }
+    return val;
+}
+
+/**
+ * @brief Sign extends a value.
+ *
+ * @param val The value to extend.
+ * @param size The size of the value, in bytes. Between 1 and 8.
+ * @return The extended value.
+ */
+Address sign_extend(uint64_t val, size_t size) {
+    auto shift = (sizeof(uint64_t) - size) * 8;
+    return static_cast<Address>(static_cast<int64_t>(val << shift) >> shift);
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+struct DecodedInstruction {
+    size_t length;
+    bool has_reference;
+    X86Reference reference;
+};
+
+/**
+ * @brief Decodes a single instruction.
+ *
+ * @param code The bytes of the instruction, and possibly more after it.
+ * @param is_64_bit True if the code is 64-bit, false if 32-bit.
+ * @param address The address of the instruction, used to resolve relative references.
+ * @param decoded The struct to fill with the decoded instruction.
+ * @return True if the instruction was successfully decoded.
+ */
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool decode_x86(std::span<const uint8_t> code,
+                bool is_64_bit,
+                Address address,
+                DecodedInstruction& decoded) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    auto limit = std::min(code.size(), X86_MAX_INSTRUCTION_LENGTH);
+    size_t pos = 0;
+
+    bool operand_size_prefix = false;
+    bool address_size_prefix = false;
+    bool rex_w = false;
+    for (; pos < limit; pos++) {
+        auto byte = code[pos];
+        if (is_64_bit && (byte & 0xF0) == 0x40) {
+            rex_w = (byte & 0x08) != 0;
+            continue;
+        }
+        if (!is_legacy_prefix(byte)) {
+            break;
+        }
+
+        // REX only counts if it's directly before the opcode
+        rex_w = false;
+        if (byte == 0x66) {
+            operand_size_prefix = true;
+        } else if (byte == 0x67) {
+            address_size_prefix = true;
+        }
+    }
+    if (pos >= limit) {
+        return false;
+    }
+
+    auto opcode = code[pos++];
+    OpcodeFlags flags{};
+
+    // In 32-bit code these are only VEX/EVEX if the next byte would be an invalid ModRM
+    if ((opcode == 0xC4 || opcode == 0xC5 || opcode == 0x62) && pos < limit
+        && (is_64_bit || code[pos] >= 0xC0)) {
+        uint8_t map = 1;
+        size_t prefix_size = 1;
+        if (opcode == 0xC4) {
+            map = code[pos] & 0x1F;
+            prefix_size = 2;
+        } else if (opcode == 0x62) {
+            map = code[pos] & 0x07;
+            prefix_size = 3;
+        }
+
+        pos += prefix_size;
+        if (pos >= limit) {
+            return false;
+        }
+        opcode = code[pos++];
+
+        switch (map) {
+            case 1:
+                flags = TWO_BYTE_TABLE[opcode];
+                break;
+            case 2:
+                flags = THREE_BYTE_38_FLAGS;
+                break;
+            case 3:
+                flags = THREE_BYTE_3A_FLAGS;
+                break;
+            case 5:
+            case 6:
+                flags = OP_MODRM;
+                break;
+            default:
+                return false;
+        }
+    } else if (opcode == 0x0F) {
+        if (pos >= limit) {
+            return false;
+        }
+        opcode = code[pos++];
+
+        if (opcode == 0x38 || opcode == 0x3A) {
+            if (pos >= limit) {
+                return false;
+            }
+            flags = opcode == 0x38 ? THREE_BYTE_38_FLAGS : THREE_BYTE_3A_FLAGS;
+            opcode = code[pos++];
+        } else {
+            flags = TWO_BYTE_TABLE[opcode];
+        }
+    } else {
+        flags = ONE_BYTE_TABLE[opcode];
+    }
+
+    size_t imm_z_size = operand_size_prefix && !rex_w ? 2 : 4;
+    // Near branches ignore the operand size prefix in 64-bit code
+    if (is_64_bit && (flags & OP_REL) != 0) {
+        imm_z_size = 4;
+    }
+    size_t address_size = is_64_bit ? (address_size_prefix ? 4 : 8) : (address_size_prefix ? 2 : 4);
+
+    size_t imm_size = 0;
+    imm_size += (flags & OP_IMM8) != 0 ? 1 : 0;
+    imm_size += (flags & OP_IMM16) != 0 ? 2 : 0;
+    imm_size += (flags & OP_IMMZ) != 0 ? imm_z_size : 0;
+    if ((flags & OP_IMMV) != 0) {
+        imm_size += rex_w ? 8 : imm_z_size;
+    }
+    imm_size += (flags & OP_MOFFS) != 0 ? address_size : 0;
+
+    size_t disp_size = 0;
+    decoded.has_reference = false;
+    decoded.reference.instruction = address;
+
+    if ((flags & OP_MODRM) != 0) {
+        if (pos >= limit) {
+            return false;
+        }
+        auto modrm = code[pos++];
+        auto mod = modrm >> 6;
+        auto reg = (modrm >> 3) & 0x7;
+        auto rm = modrm & 0x7;
+
+        if ((flags & OP_GROUP3) != 0 && reg < 2) {
+            imm_size += opcode == 0xF6 ? 1 : imm_z_size;
+        }
+
+        if (mod == 3) {
+            // Register operand, nothing more to decode
+        } else if (address_size == 2) {
+            if (mod == 1) {
+                disp_size = 1;
+            } else if (mod == 2 || (mod == 0 && rm == 6)) {
+                disp_size = 2;
+            }
+            if (mod == 0 && rm == 6) {
+                decoded.has_reference = true;
+                decoded.reference.kind = X86Reference::Kind::ABSOLUTE;
+            }
+        } else {
+            auto base = rm;
+            if (rm == 4) {
+                if (pos >= limit) {
+                    return false;
+                }
+                base = code[pos++] & 0x7;
+            }
+
+            if (mod == 1) {
+                disp_size = 1;
+            } else if (mod == 2) {
+                disp_size = 4;
+            } else if (rm == 5) {
+                disp_size = 4;
+                decoded.has_reference = true;
+                decoded.reference.kind =
+                    is_64_bit ? X86Reference::Kind::RIP_RELATIVE : X86Reference::Kind::ABSOLUTE;
+            } else if (rm == 4 && base == 5) {
+                disp_size = 4;
+                decoded.has_reference = true;
+                decoded.reference.kind = X86Reference::Kind::ABSOLUTE;
+            }
+        }
+    }
+
+    decoded.length = pos + disp_size + imm_size;
+    if (decoded.length > limit) {
+        return false;
+    }
+
+    auto next_instruction = address + decoded.length;
+    // Wrap addresses the same way the cpu would
+    auto wrap = [address_size](Address addr) {
+        return address_size == 8 ? addr : addr & ((Address{1} << (address_size * 8)) - 1);
+    };
+
+    if (decoded.has_reference) {
+        auto disp = sign_extend(read_little_endian(&code[pos], disp_size), disp_size);
+        decoded.reference.target =
+            wrap(decoded.reference.kind == X86Reference::Kind::RIP_RELATIVE
+                     ? next_instruction + disp
+                     : disp);
+    } else if ((flags & OP_MOFFS) != 0) {
+        decoded.has_reference = true;
+        decoded.reference.kind = X86Reference::Kind::ABSOLUTE;
+        decoded.reference.target = read_little_endian(&code[pos + disp_size], address_size);
+    } else if ((flags & OP_REL) != 0) {
+        auto offset = sign_extend(read_little_endian(&code[pos + disp_size], imm_size), imm_size);
+        decoded.has_reference = true;
+        decoded.reference.kind = X86Reference::Kind::BRANCH;
+        decoded.reference.target = next_instruction + offset;
+        if (!is_64_bit) {
+            decoded.reference.target &= std::numeric_limits<uint32_t>::max();
+        }
+    }
+
+    return true;
+    // NOLINTEND(readability-magic-numbers)
+}
+
+}  // namespace
+
+size_t x86_instruction_length(std::span<const uint8_t> code, bool is_64_bit) {
+    DecodedInstruction decoded{};
+    if (!decode_x86(code, is_64_bit, 0, decoded)) {
+        return 0;
+    }
+    return decoded.length;
+}
+
+std::vector<X86Reference> read_x86_references(const ProcessInfo& process,
+                                              Address address,
+                                              size_t num_instructions) {
+    std::vector<uint8_t> code(num_instructions * X86_MAX_INSTRUCTION_LENGTH);
+
+    // Reading the worst case length might run off the end of readable memory, in which case fall
+    // back to reading page by page, and decode as much as we got
+    if (!read_mem(process, address, code.data(), code.size())) {
+        size_t read_size = 0;
+        while (read_size < code.size()) {
+            auto read_addr = address + read_size;
+            auto page_remaining = X86_PAGE_SIZE - (read_addr & (X86_PAGE_SIZE - 1));
+            auto size = std::min<size_t>(page_remaining, code.size() - read_size);
+            if (!read_mem(process, read_addr, &code[read_size], size)) {
+                break;
+            }
+            read_size += size;
+        }
+        code.resize(read_size);
+    }
+
+    std::vector<X86Reference> references{};
+    size_t offset = 0;
+    for (size_t i = 0; i < num_instructions; i++) {
+        DecodedInstruction decoded{};
+        if (!decode_x86(std::span{code}.subspan(offset), process.is_64_bit, address + offset,
+                        decoded)) {
+            break;
+        }
+        if (decoded.has_reference) {
+            references.push_back(decoded.reference);
+        }
+        offset += decoded.length;
+    }
+    return references;
+}
+
+}  // namespace v0
+}  // namespace asr_utils
@@ -0,0 +1,58 @@
+#ifndef ASR_UTILS_X86_DECODER_H
+#define ASR_UTILS_X86_DECODER_H
+
+#include "asr_utils/pch.h"
+#include "asr_utils/process_info.h"
+
+namespace asr_utils {
+inline namespace v0 {
+
+/**
+ * @brief An address referenced by an x86 instruction.
+ */
+struct X86Reference {
+    enum class Kind : uint8_t {
+        // A `[rip+disp32]` memory operand.
+        RIP_RELATIVE,
+        // A memory operand at a fixed address, e.g. `[disp32]`, `[index*scale+disp32]` or `moffs`.
+        ABSOLUTE,
+        // The target of a relative jump or call.
+        BRANCH
+    };
+
+    Address instruction;
+    Kind kind;
+    Address target;
+};
+
+/**
+ * @brief Gets the length of a single x86 instruction.
+ * @note Only decodes enough to work out the length, doesn't validate the instruction.
+ *
+ * @param code The bytes of the instruction, and possibly more after it.
+ * @param is_64_bit True if the code is 64-bit, false if 32-bit.
+ * @return The length of the instruction, or 0 if it couldn't be decoded.
+ */
+size_t x86_instruction_length(std::span<const uint8_t> code, bool is_64_bit);
+
+/**
+ * @brief Decodes a sequence of instructions, and extracts all fixed addresses they reference.
+ * @note Stops early if it reaches an instruction it can't decode.
+ * @note Memory operands using a base register can't be resolved, and are not included.
+ *
+ * @param process The process to read memory of.
+ * @param address The address of the first instruction, e.g. from a sigscan.
+ * @param num_instructions The number of instructions to decode.
+ * @return All references found, in instruction order.
+ */
+std::vector<X86Reference> read_x86_references(const ProcessInfo& process,
+                                              Address address,
+                                              size_t num_instructions);
+std::vector<X86Reference> read_x86_references(ProcessId process,
+                                              Address address,
+                                              size_t num_instructions) = delete;
+
+}  // namespace v0
+}  // namespace asr_utils
+
+#endif /* ASR_UTILS_X86_DECODER_H */
@@ -0,0 +1,150 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "stub_runtime.h"
+
+// Checks cached pointer paths give the same result as a full walk, while only the levels they
+// re-read change, and that changes to earlier levels are picked up once they revalidate.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t ITERATIONS = 200;
+const constexpr size_t TICKS = 50;
+const constexpr size_t MAX_OFFSETS = 7;
+const constexpr size_t MAX_REREAD_LEVELS = 3;
+const constexpr size_t MAX_REVALIDATE_INTERVAL = 10;
+
+// Each level's nodes are placed in their own region, so relinking one level never overwrites
+// another's pointers
+const constexpr size_t REGION_SIZE = 0x1000;
+const constexpr size_t NODE_SIZE = 0x20;
+const constexpr size_t MAX_OFFSET_SLOTS = 4;
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+size_t failures = 0;
+
+/**
+ * @brief Writes a 64-bit address into the fake process's memory.
+ *
+ * @param address The address to write at.
+ * @param value The value to write.
+ */
+void write_address(Address address, Address value) {
+    auto val = static_cast<uint64_t>(value);
+    memcpy(&stub_runtime::memory()[address - stub_runtime::BASE], &val, sizeof(val));
+}
+
+/**
+ * @brief A random pointer path, laid out in memory one region per level.
+ */
+struct Path {
+    DeepPointer ptr{stub_runtime::BASE, {}};
+    std::vector<Address> nodes;
+
+    /**
+     * @brief Constructs a new random path.
+     */
+    Path(void) {
+        auto num_offsets = 1 + (rng() % MAX_OFFSETS);
+        for (size_t i = 0; i < num_offsets; i++) {
+            this->ptr.offsets.push_back(
+                static_cast<ptrdiff_t>((rng() % MAX_OFFSET_SLOTS) * sizeof(uint64_t)));
+        }
+        this->nodes.resize(num_offsets);
+        this->relink(0);
+    }
+
+    /**
+     * @brief Moves every level from the given one onwards to a new random node.
+     *
+     * @param start The first level to move.
+     */
+    void relink(size_t start) {
+        for (size_t i = start; i < this->nodes.size(); i++) {
+            this->nodes[i] = stub_runtime::BASE + ((i + 1) * REGION_SIZE)
+                             + ((rng() % (REGION_SIZE / NODE_SIZE)) * NODE_SIZE);
+            if (i == 0) {
+                write_address(this->ptr.base, this->nodes[i]);
+            } else {
+                write_address(this->nodes[i - 1] + this->ptr.offsets[i - 1], this->nodes[i]);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Dereferences a random cached path over several ticks, relinking the levels it re-reads.
+ *
+ * @param process The process to read the pointer in.
+ */
+void check_path(const ProcessInfo& process) {
+    Path path{};
+    auto reread_levels = 1 + (rng() % MAX_REREAD_LEVELS);
+    auto revalidate_interval = rng() % MAX_REVALIDATE_INTERVAL;
+    CachedDeepPointer cached{path.ptr, reread_levels, revalidate_interval};
+
+    auto num_levels = path.nodes.size();
+    auto first_reread = num_levels - std::min(reread_levels, num_levels);
+
+    for (size_t tick = 0; tick < TICKS; tick++) {
+        if (rng() % 2 == 0) {
+            path.relink(first_reread);
+        }
+
+        auto reads_before = stub_runtime::num_reads();
+        auto saved_before = cached.num_reads_saved();
+        auto addr = cached.dereference(process);
+        auto reads = stub_runtime::num_reads() - reads_before;
+        auto saved = cached.num_reads_saved() - saved_before;
+
+        if (addr != path.ptr.dereference(process)) {
+            failures++;
+            printf("cached pointer mismatch: %zu levels, re-reading %zu\n", num_levels,
+                   reread_levels);
+        }
+        if (reads + saved != num_levels) {
+            failures++;
+            printf("cached pointer made %llu reads and saved %llu, over %zu levels\n",
+                   static_cast<unsigned long long>(reads), static_cast<unsigned long long>(saved),
+                   num_levels);
+        }
+    }
+
+    // Changing an earlier level is missed until the next full walk, which is at most the revalidate
+    // interval away
+    path.relink(0);
+    auto expected = path.ptr.dereference(process);
+    size_t ticks = 0;
+    while (cached.dereference(process) != expected && ticks <= revalidate_interval) {
+        ticks++;
+    }
+    if (ticks > revalidate_interval) {
+        failures++;
+        printf("cached pointer didn't revalidate within %zu ticks\n", revalidate_interval);
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    stub_runtime::memory().assign((MAX_OFFSETS + 1) * REGION_SIZE, 0);
+
+    ProcessInfo process{};
+    process.pid = stub_runtime::PID;
+    process.is_64_bit = true;
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        check_path(process);
+    }
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
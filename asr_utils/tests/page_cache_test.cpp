@@ -0,0 +1,118 @@
+#include <asr_utils.h>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "stub_runtime.h"
+
+// Checks reads through the page cache give the same result as uncached reads, over several ticks
+// with memory changing in between, including reads crossing pages and partially unreadable pages.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t MEMORY_SIZE = 0x100000;
+const constexpr size_t TICKS = 200;
+const constexpr size_t READS_PER_TICK = 300;
+const constexpr size_t WRITES_PER_TICK = 100;
+const constexpr size_t MAX_READ_SIZE = 64;
+const constexpr size_t CACHE_CAPACITY = 16;
+
+// Most reads are placed in a small region, so that pages get reused
+const constexpr Address HOT_REGION = 0x20000;
+const constexpr size_t HOT_REGION_SIZE = 0x3000;
+
+// NOLINTBEGIN(readability-magic-numbers)
+const constexpr Address UNREADABLE_PAGE = 0x8000;
+const constexpr Address PARTIALLY_UNREADABLE_START = HOT_REGION + 0x800;
+const constexpr Address PARTIALLY_UNREADABLE_END = HOT_REGION + 0x900;
+// NOLINTEND(readability-magic-numbers)
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+size_t failures = 0;
+
+/**
+ * @brief Picks a random address to read from.
+ *
+ * @return The address.
+ */
+Address random_address(void) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    switch (rng() % 8) {
+        case 0:
+            return stub_runtime::BASE + (rng() % MEMORY_SIZE);
+        case 1:
+            // Right before the unreadable page, often running into it
+            return stub_runtime::BASE + UNREADABLE_PAGE - (rng() % MAX_READ_SIZE);
+        default:
+            // Some start just before the hot region, so they cross into the page before it
+            return stub_runtime::BASE + HOT_REGION + (rng() % HOT_REGION_SIZE) - 4;
+    }
+    // NOLINTEND(readability-magic-numbers)
+}
+
+}  // namespace
+
+int main(void) {
+    auto& memory = stub_runtime::memory();
+    memory.resize(MEMORY_SIZE);
+    for (auto& byte : memory) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    stub_runtime::add_unreadable(stub_runtime::BASE + UNREADABLE_PAGE,
+                                 stub_runtime::BASE + UNREADABLE_PAGE + PageCache::PAGE_SIZE);
+    stub_runtime::add_unreadable(stub_runtime::BASE + PARTIALLY_UNREADABLE_START,
+                                 stub_runtime::BASE + PARTIALLY_UNREADABLE_END);
+
+    ProcessInfo uncached{};
+    uncached.pid = stub_runtime::PID;
+    uncached.is_64_bit = true;
+    ProcessInfo cached = uncached;
+    cached.enable_page_cache(CACHE_CAPACITY);
+
+    uint64_t cached_reads = 0;
+    uint64_t uncached_reads = 0;
+    for (size_t tick = 0; tick < TICKS; tick++) {
+        cached.invalidate_page_cache();
+        for (size_t i = 0; i < WRITES_PER_TICK; i++) {
+            memory[rng() % MEMORY_SIZE] = static_cast<uint8_t>(rng());
+        }
+
+        for (size_t i = 0; i < READS_PER_TICK; i++) {
+            auto address = random_address();
+            auto size = 1 + (rng() % MAX_READ_SIZE);
+            std::array<uint8_t, MAX_READ_SIZE> cached_buf{};
+            std::array<uint8_t, MAX_READ_SIZE> uncached_buf{};
+
+            auto reads_before = stub_runtime::num_reads();
+            auto cached_success = read_mem(cached, address, cached_buf.data(), size);
+            auto reads_between = stub_runtime::num_reads();
+            auto uncached_success = read_mem(uncached, address, uncached_buf.data(), size);
+            cached_reads += reads_between - reads_before;
+            uncached_reads += stub_runtime::num_reads() - reads_between;
+
+            if (cached_success != uncached_success
+                || (cached_success && memcmp(cached_buf.data(), uncached_buf.data(), size) != 0)) {
+                failures++;
+                printf("page cache mismatch: 0x%llx, size %zu, expected %d, got %d\n",
+                       static_cast<unsigned long long>(address), size, uncached_success,
+                       cached_success);
+            }
+        }
+    }
+
+    if (cached_reads >= uncached_reads) {
+        failures++;
+        printf("page cache made %llu host reads, uncached reads made %llu\n",
+               static_cast<unsigned long long>(cached_reads),
+               static_cast<unsigned long long>(uncached_reads));
+    }
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <cstring>
+
+#include "stub_runtime.h"
+
+// Checks the pointer failure cache's counters and results across a path which fails, keeps failing
+// with the same parent, then recovers either by the failed level or its parent changing.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t MEMORY_SIZE = 0x1000;
+const constexpr size_t FAILING_TICKS = 100;
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// The path is base -> first -> second -> third -> fourth -> fifth, with each level read 8 bytes
+// into the previous one, and the final offset being 4
+const constexpr Address FIRST = stub_runtime::BASE + 0x100;
+const constexpr Address SECOND = stub_runtime::BASE + 0x200;
+const constexpr Address THIRD = stub_runtime::BASE + 0x300;
+const constexpr Address FOURTH = stub_runtime::BASE + 0x400;
+const constexpr Address FIFTH = stub_runtime::BASE + 0x500;
+const constexpr ptrdiff_t LEVEL_OFFSET = 8;
+const constexpr ptrdiff_t FINAL_OFFSET = 4;
+
+// An alternate third level, for when the parent of the failed level changes
+const constexpr Address OTHER_THIRD = stub_runtime::BASE + 0x600;
+
+// The path fails reading the fourth level, out of the third, which is the 3rd level after the base
+const constexpr size_t FAILED_LEVEL = 3;
+
+// NOLINTEND(readability-magic-numbers)
+
+// A full walk up to the failure reads the base and every level up to the failed one
+const constexpr uint64_t FAILED_WALK_READS = FAILED_LEVEL + 1;
+// A short-circuit only reads the failed level and its parent
+const constexpr uint64_t SHORT_CIRCUIT_READS = 2;
+
+size_t failures = 0;
+
+/**
+ * @brief Writes a 64-bit address into the fake process's memory.
+ *
+ * @param address The address to write at.
+ * @param value The value to write.
+ */
+void write_address(Address address, Address value) {
+    auto val = static_cast<uint64_t>(value);
+    memcpy(&stub_runtime::memory()[address - stub_runtime::BASE], &val, sizeof(val));
+}
+
+/**
+ * @brief Checks a condition, printing a message if it fails.
+ *
+ * @param condition The condition.
+ * @param msg The message to print.
+ */
+void check(bool condition, const char* msg) {
+    if (!condition) {
+        failures++;
+        printf("%s\n", msg);
+    }
+}
+
+/**
+ * @brief Dereferences a pointer through a failure cache, counting the host reads it took.
+ *
+ * @param process The process to read the pointer in.
+ * @param ptr The pointer to dereference.
+ * @param cache The failure cache to use.
+ * @param reads Set to the number of host reads the dereference took.
+ * @return The dereferenced address.
+ */
+Address dereference(const ProcessInfo& process,
+                    const DeepPointer& ptr,
+                    PointerFailureCache& cache,
+                    uint64_t& reads) {
+    auto reads_before = stub_runtime::num_reads();
+    auto addr = ptr.dereference(process, cache);
+    reads = stub_runtime::num_reads() - reads_before;
+    return addr;
+}
+
+}  // namespace
+
+int main(void) {
+    stub_runtime::memory().assign(MEMORY_SIZE, 0);
+    write_address(stub_runtime::BASE, FIRST);
+    write_address(FIRST + LEVEL_OFFSET, SECOND);
+    write_address(SECOND + LEVEL_OFFSET, THIRD);
+    write_address(THIRD + LEVEL_OFFSET, 0);
+    write_address(OTHER_THIRD + LEVEL_OFFSET, FOURTH);
+    write_address(FOURTH + LEVEL_OFFSET, FIFTH);
+
+    ProcessInfo process{};
+    process.pid = stub_runtime::PID;
+    process.is_64_bit = true;
+
+    const DeepPointer ptr{stub_runtime::BASE,
+                          {LEVEL_OFFSET, LEVEL_OFFSET, LEVEL_OFFSET, LEVEL_OFFSET, FINAL_OFFSET}};
+    PointerFailureCache cache{};
+    uint64_t reads = 0;
+
+    // The first failure walks the full path
+    check(dereference(process, ptr, cache, reads) == 0, "failing path dereferenced");
+    check(reads == FAILED_WALK_READS, "first failure didn't walk the full path");
+    check(cache.num_short_circuits() == 0 && cache.num_reads_avoided() == 0,
+          "first failure counted as a short-circuit");
+
+    // While the parent is unchanged, most dereferences short-circuit, each avoiding the reads
+    // before the failed level's parent, with full walks backing off in between
+    uint64_t full_walks = 0;
+    for (size_t i = 0; i < FAILING_TICKS; i++) {
+        check(dereference(process, ptr, cache, reads) == 0, "failing path dereferenced");
+        if (reads == FAILED_WALK_READS) {
+            full_walks++;
+        } else {
+            check(reads == SHORT_CIRCUIT_READS, "short-circuit read more than the failed level");
+        }
+    }
+    check(cache.num_short_circuits() == FAILING_TICKS - full_walks,
+          "short-circuit count doesn't match the short-circuited dereferences");
+    check(cache.num_reads_avoided()
+              == cache.num_short_circuits() * (FAILED_WALK_READS - SHORT_CIRCUIT_READS),
+          "reads avoided doesn't match the short-circuited dereferences");
+    check(full_walks > 0 && full_walks < FAILING_TICKS / 4, "full walks didn't back off");
+
+    // Changing the parent of the failed level is noticed straight away, without waiting for the
+    // next full walk. Fail, short-circuit, then fail again first, so that the backoff is 2, and a
+    // retry is still pending after this.
+    cache.reset();
+    for (size_t i = 0; i < 3; i++) {  // NOLINT(readability-magic-numbers)
+        check(dereference(process, ptr, cache, reads) == 0, "failing path dereferenced");
+    }
+    auto short_circuits = cache.num_short_circuits();
+    auto reads_avoided = cache.num_reads_avoided();
+    write_address(SECOND + LEVEL_OFFSET, OTHER_THIRD);
+    check(dereference(process, ptr, cache, reads) == FIFTH + FINAL_OFFSET,
+          "parent change wasn't noticed");
+    check(cache.num_short_circuits() == short_circuits
+              && cache.num_reads_avoided() == reads_avoided,
+          "parent change counted as a short-circuit");
+
+    // Succeeding forgets the failure, so failing again walks the full path, even though the old
+    // failure would otherwise have been short-circuited
+    write_address(SECOND + LEVEL_OFFSET, THIRD);
+    check(dereference(process, ptr, cache, reads) == 0 && reads == FAILED_WALK_READS,
+          "failure after success didn't walk the full path");
+
+    // The failed level becoming valid is noticed straight away too
+    write_address(THIRD + LEVEL_OFFSET, FOURTH);
+    check(dereference(process, ptr, cache, reads) == FIFTH + FINAL_OFFSET,
+          "failed level becoming valid wasn't noticed");
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
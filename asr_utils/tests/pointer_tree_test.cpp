@@ -0,0 +1,122 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "stub_runtime.h"
+
+// Checks pointer trees resolve every path to the same address as dereferencing it on it's own,
+// over random paths sharing many prefixes, and random memory with some null pointers.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t MEMORY_SIZE = 0x1000;
+const constexpr size_t ITERATIONS = 300;
+const constexpr size_t TICKS = 5;
+const constexpr size_t MAX_PATHS = 25;
+const constexpr size_t MAX_OFFSETS = 6;
+
+// Use only a few bases and offsets, so that paths often share prefixes
+const constexpr size_t NUM_BASES = 3;
+const constexpr size_t NUM_OFFSETS = 3;
+
+// One in this many pointers in memory are null
+const constexpr size_t NULL_CHANCE = 8;
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+size_t failures = 0;
+
+/**
+ * @brief Fills the fake process's memory with random pointers back into it.
+ */
+void randomise_memory(void) {
+    auto& memory = stub_runtime::memory();
+    for (size_t i = 0; i < MEMORY_SIZE; i += sizeof(uint64_t)) {
+        // Keep pointers away from the edges, so that every offset stays within memory
+        uint64_t val = rng() % NULL_CHANCE == 0
+                           ? 0
+                           : stub_runtime::BASE + sizeof(uint64_t)
+                                 + ((rng() % ((MEMORY_SIZE / sizeof(uint64_t)) - NUM_OFFSETS))
+                                    * sizeof(uint64_t));
+        memcpy(&memory[i], &val, sizeof(val));
+    }
+}
+
+/**
+ * @brief Builds a random pointer path.
+ *
+ * @return The path.
+ */
+DeepPointer random_path(void) {
+    DeepPointer ptr{stub_runtime::BASE + ((rng() % NUM_BASES) * sizeof(uint64_t)), {}};
+    auto num_offsets = rng() % MAX_OFFSETS;
+    for (size_t i = 0; i < num_offsets; i++) {
+        // Offsets of -8, 0 and 8, to cover negative ones too
+        ptr.offsets.push_back(static_cast<ptrdiff_t>((rng() % NUM_OFFSETS) * sizeof(uint64_t))
+                              - static_cast<ptrdiff_t>(sizeof(uint64_t)));
+    }
+    return ptr;
+}
+
+/**
+ * @brief Resolves a random tree over several ticks, and compares it against each path.
+ *
+ * @param process The process to read the pointers in.
+ */
+void check_tree(const ProcessInfo& process) {
+    PointerTree tree{};
+    std::vector<DeepPointer> paths{};
+    std::vector<PointerTree::Handle> handles{};
+    auto num_paths = 1 + (rng() % MAX_PATHS);
+    for (size_t i = 0; i < num_paths; i++) {
+        paths.push_back(random_path());
+        handles.push_back(tree.add(paths.back()));
+    }
+
+    for (size_t tick = 0; tick < TICKS; tick++) {
+        randomise_memory();
+
+        auto reads_before = stub_runtime::num_reads();
+        tree.resolve(process);
+        auto tree_reads = stub_runtime::num_reads() - reads_before;
+
+        reads_before = stub_runtime::num_reads();
+        for (size_t i = 0; i < num_paths; i++) {
+            if (tree.get(handles[i]) != paths[i].dereference(process)) {
+                failures++;
+                printf("pointer tree mismatch: path %zu of %zu\n", i, num_paths);
+            }
+        }
+        auto path_reads = stub_runtime::num_reads() - reads_before;
+
+        if (tree_reads != tree.num_reads() || tree_reads > path_reads) {
+            failures++;
+            printf("pointer tree made %llu reads, reported %zu, paths on their own made %llu\n",
+                   static_cast<unsigned long long>(tree_reads), tree.num_reads(),
+                   static_cast<unsigned long long>(path_reads));
+        }
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    stub_runtime::memory().resize(MEMORY_SIZE);
+
+    ProcessInfo process{};
+    process.pid = stub_runtime::PID;
+    process.is_64_bit = true;
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        check_tree(process);
+    }
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
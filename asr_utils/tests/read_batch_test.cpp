@@ -0,0 +1,129 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "stub_runtime.h"
+
+// Checks batched reads give the same result as reading each request individually, over random
+// requests clustered in a small region, some of which overlap or fall in unreadable gaps.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t MEMORY_SIZE = 0x40000;
+const constexpr size_t ITERATIONS = 2000;
+const constexpr size_t MAX_REQUESTS = 40;
+const constexpr size_t MAX_REQUEST_SIZE = 32;
+const constexpr size_t MAX_GAP_SIZE = 0x100;
+
+// Requests are placed within a region this big, so that many of them get merged
+const constexpr size_t REGION_SIZE = 0x800;
+
+// Placeholder for bytes which weren't written to
+const constexpr uint8_t UNWRITTEN = 0xEE;
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+size_t failures = 0;
+
+/**
+ * @brief Runs a random batch, and compares it against individual reads.
+ */
+void check_batch(void) {
+    stub_runtime::clear_unreadable();
+    if (rng() % 2 == 0) {
+        auto start = stub_runtime::BASE + (rng() % MEMORY_SIZE);
+        stub_runtime::add_unreadable(start, start + (rng() % MAX_GAP_SIZE));
+    }
+
+    ReadBatch batch{rng() % 2 == 0 ? 0 : ReadBatch::DEFAULT_MAX_GAP};
+    auto region = stub_runtime::BASE + (rng() % (MEMORY_SIZE - REGION_SIZE));
+
+    auto num_requests = rng() % MAX_REQUESTS;
+    std::vector<Address> addresses(num_requests);
+    std::vector<std::vector<uint8_t>> dests(num_requests);
+    std::vector<size_t> ids(num_requests);
+    for (size_t i = 0; i < num_requests; i++) {
+        // Occasionally read entirely outside of the process's memory
+        addresses[i] = rng() % 10 == 0  // NOLINT(readability-magic-numbers)
+                           ? stub_runtime::BASE + MEMORY_SIZE + (rng() % REGION_SIZE)
+                           : region + (rng() % REGION_SIZE);
+        dests[i].assign(1 + (rng() % MAX_REQUEST_SIZE), UNWRITTEN);
+        ids[i] = batch.add(addresses[i], dests[i].data(), dests[i].size());
+    }
+
+    auto reads_before = stub_runtime::num_reads();
+    auto all_succeeded = batch.execute(stub_runtime::PID);
+    auto host_reads = stub_runtime::num_reads() - reads_before;
+
+    if (host_reads != batch.host_reads()) {
+        failures++;
+        printf("read batch made %llu host reads, but reported %zu\n",
+               static_cast<unsigned long long>(host_reads), batch.host_reads());
+    }
+
+    bool expected_all_succeeded = true;
+    for (size_t i = 0; i < num_requests; i++) {
+        std::vector<uint8_t> expected(dests[i].size(), UNWRITTEN);
+        auto success = process_read(stub_runtime::PID, addresses[i], expected.data(),
+                                    expected.size());
+        expected_all_succeeded &= success;
+
+        if (success != batch.succeeded(ids[i]) || (success && expected != dests[i])) {
+            failures++;
+            printf("read batch mismatch: 0x%llx, size %zu, expected %d, got %d\n",
+                   static_cast<unsigned long long>(addresses[i]), dests[i].size(), success,
+                   batch.succeeded(ids[i]));
+        }
+    }
+
+    if (all_succeeded != expected_all_succeeded) {
+        failures++;
+        printf("read batch overall result mismatch, expected %d, got %d\n", expected_all_succeeded,
+               all_succeeded);
+    }
+}
+
+/**
+ * @brief Checks that a batch of adjacent reads gets merged into a single host call.
+ */
+void check_merged(void) {
+    stub_runtime::clear_unreadable();
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    uint32_t first{};
+    uint64_t second{};
+    uint16_t third{};
+    ReadBatch batch{};
+    batch.add(stub_runtime::BASE + 0x100, first);
+    batch.add(stub_runtime::BASE + 0x104, second);
+    batch.add(stub_runtime::BASE + 0x120, third);
+    // NOLINTEND(readability-magic-numbers)
+
+    if (!batch.execute(stub_runtime::PID) || batch.host_reads() != 1) {
+        failures++;
+        printf("read batch of adjacent reads took %zu host reads\n", batch.host_reads());
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    auto& memory = stub_runtime::memory();
+    memory.resize(MEMORY_SIZE);
+    for (auto& byte : memory) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        check_batch();
+    }
+    check_merged();
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
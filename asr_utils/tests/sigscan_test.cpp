@@ -0,0 +1,273 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <random>
+#include <tuple>
+
+#include "stub_runtime.h"
+
+// Checks the sigscan matchers, multi-pattern scans, and stepped jobs, against a brute force search,
+// over random buffers with some unreadable pages. Which matchers get run depends on the build -
+// native builds test the scalar paths, the `wasm-simd` preset tests the simd128 kernels.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t PAGE_SIZE = 0x1000;
+const constexpr size_t ITERATIONS = 200;
+const constexpr size_t MAX_PAGES = 0x20;
+
+// The largest byte budget to step jobs with
+const constexpr size_t MAX_JOB_BUDGET = 5000;
+
+// The size of the first read a scan makes, so the first boundary between chunks
+const constexpr size_t FIRST_READ_SIZE = 0x10000;
+
+// Use a small alphabet, so that partial and full matches are both common
+const constexpr uint8_t ALPHABET_SIZE = 4;
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+size_t failures = 0;
+
+/**
+ * @brief Finds every match of a pattern by checking every offset.
+ *
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return All matches, including the pattern's offset.
+ */
+std::vector<Address> brute_force(const PatternView& pattern, Address start, size_t size) {
+    std::vector<Address> matches{};
+    auto& memory = stub_runtime::memory();
+    for (auto addr = start; addr + pattern.size <= start + size; addr++) {
+        if (!stub_runtime::is_readable(addr, pattern.size)) {
+            continue;
+        }
+
+        bool match = true;
+        for (size_t i = 0; i < pattern.size; i++) {
+            if ((memory[addr - stub_runtime::BASE + i] & pattern.mask[i]) != pattern.bytes[i]) {
+                match = false;
+                break;
+            }
+        }
+        if (match) {
+            matches.push_back(addr + pattern.offset);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Creates a random pattern.
+ * @note Picks between a fully solid pattern, one ending in a solid run, and a fully random one,
+ *       so that every matcher gets used.
+ *
+ * @tparam n The size of the pattern.
+ * @return The pattern.
+ */
+template <size_t n>
+Pattern<n> random_pattern(void) {
+    enum { SOLID, SOLID_SUFFIX, RANDOM };
+    auto shape = rng() % 3;
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    uint8_t bytes[n];
+    uint8_t mask[n];
+    for (size_t i = 0; i < n; i++) {
+        auto solid = shape == SOLID || (shape == SOLID_SUFFIX && i + 5 > n) || rng() % 3 != 0;
+        mask[i] = solid ? 0xFF : (rng() % 2 == 0 ? 0x00 : 0xF0);
+        bytes[i] = (rng() % ALPHABET_SIZE) & mask[i];
+    }
+    // NOLINTEND(readability-magic-numbers)
+
+    return {bytes, mask, static_cast<ptrdiff_t>(rng() % 3)};
+}
+
+/**
+ * @brief Checks a random pattern over a random part of the buffer.
+ *
+ * @tparam n The size of the pattern.
+ */
+template <size_t n>
+void check_pattern(void) {
+    auto pattern = random_pattern<n>();
+    auto view = pattern.view();
+
+    auto size = stub_runtime::memory().size();
+    auto offset = rng() % size;
+    auto start = stub_runtime::BASE + offset;
+    auto len = rng() % (size - offset + 1);
+
+    auto expected = brute_force(view, start, len);
+
+    std::vector<Address> all{};
+    for (auto addr : sigscan_all(stub_runtime::PID, pattern, start, len)) {
+        all.push_back(addr);
+    }
+    auto first = sigscan(stub_runtime::PID, pattern, start, len);
+
+    auto expected_first = expected.empty() ? 0 : expected.front();
+    if (all != expected || first != expected_first) {
+        failures++;
+        printf("mismatch: size %zu, matcher %d, expected %zu matches, sigscan_all found %zu\n", n,
+               static_cast<int>(view.matcher), expected.size(), all.size());
+    }
+}
+
+/**
+ * @brief Writes a copy of a pattern into a region, often straddling the boundary between the first
+ *        two reads a scan makes, so that matches crossing chunks get tested.
+ *
+ * @param pattern The pattern to write.
+ * @param start The start of the region.
+ * @param len The length of the region.
+ */
+void plant_pattern(const PatternView& pattern, Address start, size_t len) {
+    if (len < pattern.size) {
+        return;
+    }
+
+    auto offset = rng() % (len - pattern.size + 1);
+    if (rng() % 2 == 0 && FIRST_READ_SIZE + 1 < len && pattern.size > 1) {
+        offset = FIRST_READ_SIZE - 1 - (rng() % (pattern.size - 1));
+        if (offset + pattern.size > len) {
+            return;
+        }
+    }
+
+    auto& memory = stub_runtime::memory();
+    std::copy_n(pattern.bytes, pattern.size, &memory[start - stub_runtime::BASE + offset]);
+}
+
+/**
+ * @brief Checks scanning for several random patterns at once over a random part of the buffer.
+ */
+void check_many(void) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    std::tuple patterns{random_pattern<1>(), random_pattern<4>(), random_pattern<9>(),
+                        random_pattern<40>()};
+    // NOLINTEND(readability-magic-numbers)
+
+    auto size = stub_runtime::memory().size();
+    auto offset = rng() % size;
+    auto start = stub_runtime::BASE + offset;
+    auto len = rng() % (size - offset + 1);
+
+    auto views = std::apply(
+        [](const auto&... pattern) { return std::array{pattern.view()...}; }, patterns);
+    for (const auto& view : views) {
+        plant_pattern(view, start, len);
+    }
+
+    auto results = std::apply(
+        [&](const auto&... pattern) {
+            return sigscan_many(stub_runtime::PID, start, len, pattern...);
+        },
+        patterns);
+
+    for (size_t i = 0; i < views.size(); i++) {
+        auto expected = brute_force(views[i], start, len);
+        auto expected_first = expected.empty() ? 0 : expected.front();
+        if (results[i] != expected_first) {
+            failures++;
+            printf("sigscan_many mismatch: size %zu, expected %llx, found %llx\n", views[i].size,
+                   static_cast<unsigned long long>(expected_first),
+                   static_cast<unsigned long long>(results[i]));
+        }
+    }
+}
+
+/**
+ * @brief Checks a sigscan job, stepped with tiny random budgets, finds the same results as a brute
+ *        force search, and stops early once everything's found.
+ */
+void check_job(void) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    std::tuple patterns{random_pattern<2>(), random_pattern<7>(), random_pattern<24>()};
+    // NOLINTEND(readability-magic-numbers)
+
+    auto size = stub_runtime::memory().size();
+    auto offset = rng() % size;
+    auto start = stub_runtime::BASE + offset;
+    auto len = rng() % (size - offset + 1);
+
+    auto views = std::apply(
+        [](const auto&... pattern) { return std::array{pattern.view()...}; }, patterns);
+    for (const auto& view : views) {
+        plant_pattern(view, start, len);
+    }
+
+    std::array<Address, views.size()> expected{};
+    for (size_t i = 0; i < views.size(); i++) {
+        auto matches = brute_force(views[i], start, len);
+        expected[i] = matches.empty() ? 0 : matches.front();
+    }
+
+    SigscanJob job{stub_runtime::PID, views, start, len};
+    auto remaining = job.bytes_remaining();
+    bool done = false;
+    // Every step scans at least a byte, so this is plenty
+    for (size_t steps = 0; !done && steps <= len + 1; steps++) {
+        // Time budgets always do a single read when given no time
+        done = rng() % 4 == 0 ? job.step(std::chrono::steady_clock::duration::zero())
+                              : job.step(1 + (rng() % MAX_JOB_BUDGET));
+        if (job.bytes_remaining() > remaining) {
+            failures++;
+            printf("sigscan job bytes remaining went up from %zu to %zu\n", remaining,
+                   job.bytes_remaining());
+        }
+        remaining = job.bytes_remaining();
+    }
+
+    auto results = job.results();
+    auto all_found =
+        std::none_of(results.begin(), results.end(), [](auto res) { return res == 0; });
+    if (!done || done != job.done() || (remaining != 0 && !all_found)
+        || !std::equal(results.begin(), results.end(), expected.begin(), expected.end())) {
+        failures++;
+        printf("sigscan job mismatch: done %d, %zu bytes remaining\n", done, remaining);
+        for (size_t i = 0; i < views.size(); i++) {
+            printf("  size %zu, expected %llx, found %llx\n", views[i].size,
+                   static_cast<unsigned long long>(expected[i]),
+                   static_cast<unsigned long long>(results[i]));
+        }
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        auto& memory = stub_runtime::memory();
+        memory.resize((1 + (rng() % MAX_PAGES)) * PAGE_SIZE);
+        for (auto& byte : memory) {
+            byte = rng() % ALPHABET_SIZE;
+        }
+
+        stub_runtime::clear_unreadable();
+        if (rng() % 2 == 0) {
+            auto page = stub_runtime::BASE + ((rng() % (memory.size() / PAGE_SIZE)) * PAGE_SIZE);
+            stub_runtime::add_unreadable(page, page + PAGE_SIZE);
+        }
+
+        // NOLINTBEGIN(readability-magic-numbers)
+        check_pattern<1>();
+        check_pattern<3>();
+        check_pattern<6>();
+        check_pattern<9>();
+        check_pattern<16>();
+        check_pattern<40>();
+        // NOLINTEND(readability-magic-numbers)
+
+        check_many();
+        check_job();
+    }
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
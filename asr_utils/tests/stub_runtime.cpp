@@ -0,0 +1,143 @@
+#include "stub_runtime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace stub_runtime {
+
+namespace {
+
+std::vector<uint8_t> memory_buffer{};
+std::vector<std::pair<Address, Address>> unreadable_ranges{};
+std::atomic<uint64_t> read_count{0};
+
+/**
+ * @brief Copies a string into a runtime style output buffer.
+ *
+ * @param str The string to copy.
+ * @param buf_ptr The buffer to copy into.
+ * @param buf_len_ptr Pointer to the buffer length, which gets set to the required size.
+ * @return True if the buffer was large enough.
+ */
+bool write_string(std::string_view str, uint8_t* buf_ptr, uintptr_t* buf_len_ptr) {
+    auto fits = buf_ptr != nullptr && *buf_len_ptr >= str.size();
+    if (fits) {
+        memcpy(buf_ptr, str.data(), str.size());
+    }
+    *buf_len_ptr = str.size();
+    return fits;
+}
+
+}  // namespace
+
+std::vector<uint8_t>& memory(void) {
+    return memory_buffer;
+}
+
+void add_unreadable(Address start, Address end) {
+    unreadable_ranges.emplace_back(start, end);
+}
+
+void clear_unreadable(void) {
+    unreadable_ranges.clear();
+}
+
+bool is_readable(Address address, size_t size) {
+    if (address < BASE || address + size > BASE + memory_buffer.size()) {
+        return false;
+    }
+    return std::none_of(unreadable_ranges.begin(), unreadable_ranges.end(), [&](auto range) {
+        return address < range.second && address + size > range.first;
+    });
+}
+
+uint64_t num_reads(void) {
+    return read_count.load();
+}
+
+}  // namespace stub_runtime
+
+extern "C" {
+
+TimerState timer_get_state(void) {
+    return TIMERSTATE_NOT_RUNNING;
+}
+void timer_start(void) {}
+void timer_split(void) {}
+void timer_reset(void) {}
+void timer_set_variable(const uint8_t* /*key_ptr*/,
+                        uintptr_t /*key_len*/,
+                        const uint8_t* /*value_ptr*/,
+                        uintptr_t /*value_len*/) {}
+void timer_set_game_time(int64_t /*secs*/, int32_t /*nanos*/) {}
+void timer_pause_game_time(void) {}
+void timer_resume_game_time(void) {}
+
+ProcessId process_attach(const uint8_t* /*name_ptr*/, uintptr_t /*name_len*/) {
+    return stub_runtime::PID;
+}
+void process_detach(ProcessId /*process*/) {}
+bool process_is_open(ProcessId process) {
+    return process == stub_runtime::PID;
+}
+
+bool process_read(ProcessId process, Address address, uint8_t* buf_ptr, uintptr_t buf_len) {
+    stub_runtime::read_count++;
+    if (process != stub_runtime::PID || !stub_runtime::is_readable(address, buf_len)) {
+        return false;
+    }
+    memcpy(buf_ptr, &stub_runtime::memory_buffer[address - stub_runtime::BASE], buf_len);
+    return true;
+}
+
+Address process_get_module_address(ProcessId /*process*/,
+                                   const uint8_t* /*name_ptr*/,
+                                   uintptr_t /*name_len*/) {
+    return stub_runtime::BASE;
+}
+uint64_t process_get_module_size(ProcessId /*process*/,
+                                 const uint8_t* /*name_ptr*/,
+                                 uintptr_t /*name_len*/) {
+    return stub_runtime::memory_buffer.size();
+}
+
+uint64_t process_get_memory_range_count(ProcessId /*process*/) {
+    return 1;
+}
+Address process_get_memory_range_address(ProcessId /*process*/, uint64_t /*idx*/) {
+    return stub_runtime::BASE;
+}
+uint64_t process_get_memory_range_size(ProcessId /*process*/, uint64_t /*idx*/) {
+    return stub_runtime::memory_buffer.size();
+}
+MemoryRangeFlags process_get_memory_range_flags(ProcessId /*process*/, uint64_t /*idx*/) {
+    return MEMORYRANGEFLAGS_READ;
+}
+
+bool process_get_path(ProcessId /*process*/, uint8_t* buf_ptr, uintptr_t* buf_len_ptr) {
+    return stub_runtime::write_string("/stub/game.exe", buf_ptr, buf_len_ptr);
+}
+
+void runtime_set_tick_rate(float64_t /*ticks_per_second*/) {}
+void runtime_print_message(const uint8_t* text_ptr, uintptr_t text_len) {
+    fprintf(stderr, "%.*s\n", static_cast<int>(text_len), reinterpret_cast<const char*>(text_ptr));
+}
+bool runtime_get_os(uint8_t* buf_ptr, uintptr_t* buf_len_ptr) {
+    return stub_runtime::write_string("linux", buf_ptr, buf_len_ptr);
+}
+bool runtime_get_arch(uint8_t* buf_ptr, uintptr_t* buf_len_ptr) {
+    return stub_runtime::write_string("x86_64", buf_ptr, buf_len_ptr);
+}
+
+bool user_settings_add_bool(const uint8_t* /*key_ptr*/,
+                            uintptr_t /*key_len*/,
+                            const uint8_t* /*description_ptr*/,
+                            uintptr_t /*description_len*/,
+                            bool default_value) {
+    return default_value;
+}
+}
@@ -0,0 +1,55 @@
+#ifndef ASR_UTILS_TESTS_STUB_RUNTIME_H
+#define ASR_UTILS_TESTS_STUB_RUNTIME_H
+
+#include <asr.h>
+#include <cstdint>
+#include <vector>
+
+// A fake ASR runtime, so the library can be run natively. It exposes a single process, whose
+// memory is a flat buffer mapped at `stub_runtime::BASE`, optionally with some unreadable ranges.
+
+namespace stub_runtime {
+
+const constexpr ProcessId PID = 1;
+const constexpr Address BASE = 0x10000;
+
+/**
+ * @brief Gets the fake process's memory, for tests to fill in.
+ * @note Must not be resized while reads may be running on other threads.
+ *
+ * @return A reference to the memory buffer.
+ */
+std::vector<uint8_t>& memory(void);
+
+/**
+ * @brief Marks a range of the fake process's memory as unreadable.
+ *
+ * @param start The start of the range.
+ * @param end The end of the range (exclusive).
+ */
+void add_unreadable(Address start, Address end);
+
+/**
+ * @brief Makes all memory readable again.
+ */
+void clear_unreadable(void);
+
+/**
+ * @brief Checks if a range of the fake process's memory can be read.
+ *
+ * @param address The start of the range.
+ * @param size The size of the range.
+ * @return True if the whole range is readable.
+ */
+bool is_readable(Address address, size_t size);
+
+/**
+ * @brief Gets the amount of `process_read` calls made so far.
+ *
+ * @return The number of reads.
+ */
+uint64_t num_reads(void);
+
+}  // namespace stub_runtime
+
+#endif /* ASR_UTILS_TESTS_STUB_RUNTIME_H */
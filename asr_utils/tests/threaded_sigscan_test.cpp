@@ -0,0 +1,97 @@
+#include <asr_utils.h>
+#include <cstdio>
+#include <random>
+
+#include "stub_runtime.h"
+
+// Checks threaded sigscans give the same result as a single threaded scan, including when the
+// match crosses a slice boundary, or when a later slice finds a match before an earlier one does.
+// Only built with ASR_UTILS_THREADS.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t PAGE_SIZE = 0x1000;
+const constexpr size_t MEMORY_SIZE = 0x1800000;
+const constexpr size_t ITERATIONS = 50;
+const constexpr size_t MAX_COPIES = 3;
+
+// Slices are always a multiple of this size, so matches placed around multiples of it often cross
+// a boundary
+const constexpr size_t SLICE_ALIGNMENT = 0x100000;
+
+const constexpr Pattern<8> PATTERN{"AB CD ?? EF 12 34 56 78", 2};
+
+std::mt19937 rng{0};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+/**
+ * @brief Picks a random place to put a copy of the pattern.
+ *
+ * @return The offset into memory to place it at.
+ */
+size_t random_placement(void) {
+    if (rng() % 2 == 0) {
+        return rng() % (MEMORY_SIZE - PATTERN.bytes.size());
+    }
+
+    auto boundary = (1 + (rng() % ((MEMORY_SIZE / SLICE_ALIGNMENT) - 1))) * SLICE_ALIGNMENT;
+    return boundary - (rng() % PATTERN.bytes.size());
+}
+
+}  // namespace
+
+int main(void) {
+    auto& memory = stub_runtime::memory();
+    memory.resize(MEMORY_SIZE);
+
+    size_t failures = 0;
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        // The filler never contains the pattern's first byte, so the only matches are the ones we
+        // place
+        std::fill(memory.begin(), memory.end(), 0);
+
+        std::vector<size_t> placed{};
+        auto num_copies = rng() % (MAX_COPIES + 1);
+        for (size_t copy = 0; copy < num_copies; copy++) {
+            auto offset = random_placement();
+            std::copy(PATTERN.bytes.begin(), PATTERN.bytes.end(), &memory[offset]);
+            placed.push_back(offset);
+        }
+
+        stub_runtime::clear_unreadable();
+        if (!placed.empty() && rng() % 2 == 0) {
+            // Hide the first copy, so the scan has to skip the page and find a later one
+            auto page = stub_runtime::BASE + (placed.front() & ~(PAGE_SIZE - 1));
+            stub_runtime::add_unreadable(page, page + PAGE_SIZE);
+        }
+
+        auto threaded = sigscan(stub_runtime::PID, PATTERN, stub_runtime::BASE, MEMORY_SIZE);
+        auto single = SigscanRange{stub_runtime::PID, PATTERN.view(), stub_runtime::BASE,
+                                   MEMORY_SIZE, 1}
+                          .next();
+
+        Address expected = 0;
+        for (auto offset : placed) {
+            auto addr = stub_runtime::BASE + offset;
+            if (stub_runtime::is_readable(addr, PATTERN.bytes.size())
+                && (expected == 0 || addr + PATTERN.offset < expected)) {
+                expected = addr + PATTERN.offset;
+            }
+        }
+
+        if (threaded != expected || single != expected) {
+            failures++;
+            printf("mismatch: expected %llx, threaded %llx, single threaded %llx\n",
+                   static_cast<unsigned long long>(expected),
+                   static_cast<unsigned long long>(threaded),
+                   static_cast<unsigned long long>(single));
+        }
+    }
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}
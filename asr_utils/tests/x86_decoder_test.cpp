@@ -0,0 +1,178 @@
+#include <asr_utils.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "stub_runtime.h"
+
+// Checks x86 instruction lengths over a list of known encodings, and that references get extracted
+// from a run of instructions, including one which ends right before an unreadable page.
+
+using namespace asr_utils;
+
+namespace {
+
+const constexpr size_t PAGE_SIZE = 0x1000;
+
+size_t failures = 0;
+
+struct LengthCase {
+    std::vector<uint8_t> code;
+    bool is_64_bit;
+    size_t length;
+};
+
+// NOLINTBEGIN(readability-magic-numbers)
+const std::vector<LengthCase> LENGTH_CASES{
+    // nop
+    {{0x90}, true, 1},
+    // push rax
+    {{0x50}, true, 1},
+    // ret
+    {{0xC3}, true, 1},
+    // mov rbp, rsp
+    {{0x48, 0x89, 0xE5}, true, 3},
+    // sub rsp, 0x20
+    {{0x48, 0x83, 0xEC, 0x20}, true, 4},
+    // mov rax, [rip+0x12345678]
+    {{0x48, 0x8B, 0x05, 0x78, 0x56, 0x34, 0x12}, true, 7},
+    // call rel32
+    {{0xE8, 0x00, 0x01, 0x00, 0x00}, true, 5},
+    // jmp rel8
+    {{0xEB, 0x05}, true, 2},
+    // je rel32
+    {{0x0F, 0x84, 0x00, 0x01, 0x00, 0x00}, true, 6},
+    // mov rax, imm64
+    {{0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}, true, 10},
+    // mov rax, [moffs64]
+    {{0x48, 0xA1, 1, 2, 3, 4, 5, 6, 7, 8}, true, 10},
+    // nop word [rax+rax+0]
+    {{0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00}, true, 6},
+    // nop dword [rax+rax+0x00000000]
+    {{0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00}, true, 8},
+    // mov dword [rsp+8], imm32
+    {{0xC7, 0x44, 0x24, 0x08, 1, 2, 3, 4}, true, 8},
+    // mov rax, imm32
+    {{0x48, 0xC7, 0xC0, 1, 2, 3, 4}, true, 7},
+    // mov ax, imm16
+    {{0x66, 0xB8, 0x34, 0x12}, true, 4},
+    // movss xmm0, [rip+disp32]
+    {{0xF3, 0x0F, 0x10, 0x05, 1, 2, 3, 4}, true, 8},
+    // mov eax, [disp32]
+    {{0x8B, 0x04, 0x25, 0x00, 0x20, 0x00, 0x00}, true, 7},
+    // call r12
+    {{0x41, 0xFF, 0xD4}, true, 3},
+    // lock cmpxchg [rdx], rcx
+    {{0xF0, 0x48, 0x0F, 0xB1, 0x0A}, true, 5},
+
+    // mov ecx, [disp32]
+    {{0x8B, 0x0D, 1, 2, 3, 4}, false, 6},
+    // mov eax, [moffs32]
+    {{0xA1, 1, 2, 3, 4}, false, 5},
+    // inc eax, which is a REX prefix in 64-bit mode
+    {{0x40}, false, 1},
+    // mov ax, imm16
+    {{0x66, 0xB8, 0x34, 0x12}, false, 4},
+    // push imm32
+    {{0x68, 1, 2, 3, 4}, false, 5},
+    // call rel32
+    {{0xE8, 0x00, 0x01, 0x00, 0x00}, false, 5},
+
+    // Truncated instructions can't be decoded
+    {{}, true, 0},
+    {{0xE8, 0x00, 0x01}, true, 0},
+    {{0x48, 0x8B, 0x05, 0x78}, true, 0},
+};
+
+// A run of 64-bit instructions, with the references in them:
+//   mov rax, [rip+0x10]       RIP_RELATIVE, offset 0 + 7 + 0x10
+//   call rel32 0x100          BRANCH, offset 7 + 5 + 0x100
+//   mov rbp, rsp
+//   mov eax, [0x2000]         ABSOLUTE, 0x2000
+//   jmp rel8 -2               BRANCH, to itself
+const std::vector<uint8_t> REFERENCE_CODE{
+    0x48, 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00, 0xE8, 0x00, 0x01, 0x00, 0x00,
+    0x48, 0x89, 0xE5, 0x8B, 0x04, 0x25, 0x00, 0x20, 0x00, 0x00, 0xEB, 0xFE,
+};
+const constexpr size_t REFERENCE_NUM_INSTRUCTIONS = 5;
+// NOLINTEND(readability-magic-numbers)
+
+/**
+ * @brief Checks the length of every instruction in `LENGTH_CASES`.
+ */
+void check_lengths(void) {
+    for (const auto& test : LENGTH_CASES) {
+        auto length = x86_instruction_length(test.code, test.is_64_bit);
+        if (length != test.length) {
+            failures++;
+            printf("x86 instruction length mismatch (%s):", test.is_64_bit ? "64-bit" : "32-bit");
+            for (auto byte : test.code) {
+                printf(" %02X", byte);
+            }
+            printf(", expected %zu, got %zu\n", test.length, length);
+        }
+    }
+}
+
+/**
+ * @brief Checks the references extracted from `REFERENCE_CODE`.
+ *
+ * @param process The process to read from.
+ * @param address The address the code was placed at.
+ * @param num_instructions The number of instructions to decode.
+ */
+void check_references(const ProcessInfo& process, Address address, size_t num_instructions) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    const std::vector<X86Reference> expected{
+        {address, X86Reference::Kind::RIP_RELATIVE, address + 7 + 0x10},
+        {address + 7, X86Reference::Kind::BRANCH, address + 7 + 5 + 0x100},
+        {address + 15, X86Reference::Kind::ABSOLUTE, 0x2000},
+        {address + 22, X86Reference::Kind::BRANCH, address + 22},
+    };
+    // NOLINTEND(readability-magic-numbers)
+
+    auto references = read_x86_references(process, address, num_instructions);
+    bool match = references.size() == expected.size();
+    for (size_t i = 0; match && i < references.size(); i++) {
+        match = references[i].instruction == expected[i].instruction
+                && references[i].kind == expected[i].kind
+                && references[i].target == expected[i].target;
+    }
+    if (!match) {
+        failures++;
+        printf("x86 references mismatch at 0x%llx, decoding %zu instructions, got %zu references\n",
+               static_cast<unsigned long long>(address), num_instructions, references.size());
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    check_lengths();
+
+    ProcessInfo process{};
+    process.pid = stub_runtime::PID;
+    process.is_64_bit = true;
+
+    auto& memory = stub_runtime::memory();
+    memory.assign(2 * PAGE_SIZE, 0);
+
+    // With plenty of readable memory after it
+    std::copy(REFERENCE_CODE.begin(), REFERENCE_CODE.end(), memory.begin());
+    check_references(process, stub_runtime::BASE, REFERENCE_NUM_INSTRUCTIONS);
+
+    // Ending right before an unreadable page, so reading the worst case length fails, and asking
+    // for more instructions than there are stops at the page boundary
+    auto offset = PAGE_SIZE - REFERENCE_CODE.size();
+    std::copy(REFERENCE_CODE.begin(), REFERENCE_CODE.end(), memory.begin() + offset);
+    auto page_end = stub_runtime::BASE + PAGE_SIZE;
+    stub_runtime::add_unreadable(page_end, page_end + PAGE_SIZE);
+    check_references(process, stub_runtime::BASE + offset, REFERENCE_NUM_INSTRUCTIONS);
+    check_references(process, stub_runtime::BASE + offset, REFERENCE_NUM_INSTRUCTIONS + 1);
+
+    if (failures != 0) {
+        printf("%zu mismatches\n", failures);
+        return 1;
+    }
+    return 0;
+}